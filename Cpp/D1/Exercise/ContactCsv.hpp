@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Streaming CSV import/export for the contact books (one contact per line; a quoted field may span lines)
+// - Reading: the file is pulled in 1 MiB chunks and handed over as batches of rows whose fields are views into
+//   the chunk, so a load does no per-field allocation and the caller can dedupe/reserve once per batch
+// - Fields may be "quoted" (with "" for a quote inside) when they contain commas, quotes or line breaks
+// - A first line starting with "name," is taken as a header and skipped
+namespace csv {
+
+constexpr std::size_t kChunkBytes = 1 << 20;
+
+struct ReadStats {
+    std::size_t rows = 0;    // Rows handed to the caller
+    std::size_t skipped = 0; // Non-empty lines without exactly the expected number of fields
+};
+
+// Splits one line into `row`; false unless it has exactly Fields fields. Quoted fields are unescaped in place
+template <std::size_t Fields>
+bool splitLine(char* begin, char* end, std::array<std::string_view, Fields>& row) {
+    std::size_t count = 0;
+    char* cursor = begin;
+    for (;;) {
+        char* fieldBegin = cursor;
+        char* fieldEnd;
+        if (cursor != end && *cursor == '"') {
+            char* out = fieldBegin; // Unescaped text is never longer, so it can overwrite the field
+            for (++cursor; cursor != end; ++cursor) {
+                if (*cursor == '"') {
+                    if (cursor + 1 == end || cursor[1] != '"') break;
+                    ++cursor; // "" is one quote
+                }
+                *out++ = *cursor;
+            }
+            if (cursor == end) return false; // Unterminated quote
+            ++cursor;
+            fieldEnd = out;
+            if (cursor != end && *cursor != ',') return false;
+        } else {
+            while (cursor != end && *cursor != ',') ++cursor;
+            fieldEnd = cursor;
+        }
+
+        if (count == Fields) return false; // Too many fields
+        row[count++] = std::string_view(fieldBegin, static_cast<std::size_t>(fieldEnd - fieldBegin));
+        if (cursor == end) break;
+        ++cursor; // Past the comma
+    }
+    return count == Fields;
+}
+
+// First line break at or after `cursor` that is not inside a quoted field (`stop` if there is none).
+// `cursor` must be at the start of a line, where no quote is open; "" toggles twice, so it needs no special case
+inline char* findLineEnd(char* cursor, char* stop) {
+    bool quoted = false;
+    for (; cursor < stop; ++cursor) {
+        if (*cursor == '"') quoted = !quoted;
+        else if (*cursor == '\n' && !quoted) break;
+    }
+    return cursor;
+}
+
+// Streams `path` and calls onBatch(const std::vector<std::array<std::string_view, Fields>>&) once per chunk.
+// The views are only valid during that call. False if the file cannot be opened or read
+template <std::size_t Fields, typename OnBatch>
+bool readRows(const std::string& path, OnBatch&& onBatch, ReadStats& stats) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    std::vector<char> buffer(kChunkBytes);
+    std::vector<std::array<std::string_view, Fields>> rows;
+    std::array<std::string_view, Fields> row;
+    std::size_t carried = 0; // Bytes of an unfinished line kept from the previous chunk
+    bool firstLine = true;
+    bool failed = false;
+
+    for (;;) {
+        if (carried == buffer.size()) buffer.resize(buffer.size() * 2); // A line longer than a chunk
+        const std::size_t got = std::fread(buffer.data() + carried, 1, buffer.size() - carried, file);
+        const std::size_t filled = carried + got;
+        const bool atEnd = got < buffer.size() - carried;
+        if (atEnd && std::ferror(file)) failed = true;
+
+        // Only whole lines are parsed; the tail waits for the next chunk (unless the file has ended)
+        char* cursor = buffer.data();
+        char* const stop = buffer.data() + filled;
+        while (cursor < stop) {
+            char* lineEnd = findLineEnd(cursor, stop);
+            if (lineEnd == stop && !atEnd) break; // Unfinished line (maybe mid-field): carry it over
+            char* next = lineEnd + 1;
+            if (lineEnd > cursor && lineEnd[-1] == '\r') --lineEnd; // Windows line endings
+
+            const std::string_view line(cursor, static_cast<std::size_t>(lineEnd - cursor));
+            const bool header = firstLine && line.rfind("name,", 0) == 0;
+            firstLine = false;
+            if (!line.empty() && !header) {
+                if (splitLine(cursor, lineEnd, row)) {
+                    rows.push_back(row);
+                } else {
+                    ++stats.skipped;
+                }
+            }
+            cursor = next;
+        }
+
+        if (!rows.empty()) {
+            stats.rows += rows.size();
+            onBatch(rows);
+            rows.clear();
+        }
+        if (atEnd) break;
+
+        const auto complete = static_cast<std::size_t>(cursor - buffer.data());
+        carried = filled - complete;
+        std::copy(buffer.begin() + complete, buffer.begin() + filled, buffer.begin());
+    }
+
+    std::fclose(file);
+    return !failed;
+}
+
+// Buffered CSV output: rows collect in memory and go to the file a chunk at a time
+class Writer {
+public:
+    Writer() = default;
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+    ~Writer() { close(); }
+
+    bool open(const std::string& path) {
+        file = std::fopen(path.c_str(), "wb");
+        pending.reserve(kChunkBytes + 4096);
+        return file != nullptr;
+    }
+
+    void row(std::initializer_list<std::string_view> fields) {
+        bool first = true;
+        for (std::string_view field : fields) {
+            if (!first) pending += ',';
+            first = false;
+            append(field);
+        }
+        pending += '\n';
+        if (pending.size() >= kChunkBytes) flush();
+    }
+
+    // Writes what is left and closes the file; false if any write failed
+    bool close() {
+        if (!file) return ok;
+        flush();
+        ok = std::fclose(file) == 0 && ok;
+        file = nullptr;
+        return ok;
+    }
+
+private:
+    void append(std::string_view field) {
+        if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+            pending.append(field);
+            return;
+        }
+        pending += '"';
+        for (char c : field) {
+            if (c == '"') pending += '"';
+            pending += c;
+        }
+        pending += '"';
+    }
+
+    void flush() {
+        if (pending.empty()) return;
+        if (!file) ok = false; // Never opened
+        else if (std::fwrite(pending.data(), 1, pending.size(), file) != pending.size()) ok = false;
+        pending.clear();
+    }
+
+    std::FILE* file = nullptr;
+    std::string pending;
+    bool ok = true;
+};
+
+} // namespace csv
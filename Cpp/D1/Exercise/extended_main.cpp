@@ -2,6 +2,8 @@
 #include<vector>
 #include<string>
 
+#include "ContactCsv.hpp"
+
 struct Contact {
     std::string name;
     std::string phone;
@@ -16,8 +18,61 @@ void displayContacts(const std::vector<Contact> & contacts){
 
 }
 
-int main(){
-    std:: vector<Contact> contacts;
+// Batch import: streams name,phone,email rows from a CSV file (a chunk at a time, not one prompt at a time)
+bool importContacts(std::vector<Contact>& contacts, const std::string& path) {
+    csv::ReadStats stats;
+    bool ok = csv::readRows<3>(path, [&](const std::vector<std::array<std::string_view, 3>>& rows) {
+        for (const auto& row : rows) {
+            contacts.push_back(Contact{std::string(row[0]), std::string(row[1]), std::string(row[2])});
+        }
+    }, stats);
+    if (!ok) {
+        std::cout << "X Could not read " << path << "\n";
+        return false;
+    }
+    std::cout << "Imported " << stats.rows << " contacts (" << stats.skipped << " malformed lines)\n";
+    return true;
+}
+
+// Batch export: writes the book in the same name,phone,email layout
+bool exportContacts(const std::vector<Contact>& contacts, const std::string& path) {
+    csv::Writer out;
+    if (!out.open(path)) {
+        std::cout << "X Could not write " << path << "\n";
+        return false;
+    }
+    out.row({"name", "phone", "email"});
+    for (const auto& contact : contacts) {
+        out.row({contact.name, contact.phone, contact.email});
+    }
+    if (!out.close()) {
+        std::cout << "X Could not write " << path << "\n";
+        return false;
+    }
+    std::cout << "Exported " << contacts.size() << " contacts to " << path << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<Contact> contacts;
+
+    // Batch mode: --import FILE fills the book first; --export FILE writes it and exits
+    std::string importPath, exportPath;
+    for (int i = 1; i < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag != "--import" && flag != "--export") {
+            std::cout << "X Unknown option " << flag << "\n";
+            return 1;
+        }
+        if (i + 1 == argc) {
+            std::cout << "X Missing value for " << flag << "\n";
+            return 1;
+        }
+        if (flag == "--import") importPath = argv[i + 1];
+        else exportPath = argv[i + 1];
+    }
+    if (!importPath.empty() && !importContacts(contacts, importPath)) return 1;
+    if (!exportPath.empty()) return exportContacts(contacts, exportPath) ? 0 : 1;
 
     while(true){
         std::cout << "\n[1] Add Contact\n[2] Show All \n[3] Exit\n> ";
@@ -1,72 +1,720 @@
+#include <version>
 #include <iostream>
 #include <string>
-#include <map>
+#include <string_view>
 #include <vector>
-#include <set>
+#include <unordered_map>
 #include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <cstddef>
+#if defined(CONTACTS_PARALLEL) && defined(__cpp_lib_execution)
+#include <execution> // Opt-in: GCC's parallel algorithms need TBB at link time (-ltbb)
+#endif
 
-// We construct the Contact
-struct Contact {
-    std::string name;
-    std::string phone;
-    std::string city;
-}; // We group by city, and name + phone is the identity.
+#include "ContactCsv.hpp" // Streaming CSV reader / writer (same format as the Day 1 books)
 
-// Displaying all Contacts
-void displayAllContacts(const std::map<std::string, std::vector<Contact>>& cityGroups){
-    for (const auto& [city, people] : cityGroups) {
-        std::cout << "\n\U0001f3d9️ " << city << ":\n";
-        for (const auto& person : people) {
-            std::cout << "- " << person.name << " (" << person.phone << ")\n";
+// Search helpers: matching ignores ASCII case
+char foldCase(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+int compareFolded(std::string_view a, std::string_view b) {
+    const std::size_t common = std::min(a.size(), b.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        const auto x = static_cast<unsigned char>(foldCase(a[i]));
+        const auto y = static_cast<unsigned char>(foldCase(b[i]));
+        if (x != y) return x < y ? -1 : 1;
+    }
+    return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+
+// How `key` sorts against `prefix` once cut to the prefix's length (0: key starts with prefix)
+int comparePrefix(std::string_view key, std::string_view prefix) {
+    return compareFolded(key.substr(0, prefix.size()), prefix);
+}
+
+// Edit distance (insert, delete, substitute, swap two neighbours) between `a` and `b`, or bound + 1 once it must
+// exceed `bound`. `rows` is scratch space reused across calls
+std::size_t editDistance(std::string_view a, std::string_view b, std::size_t bound, std::vector<std::size_t>& rows) {
+    if ((a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()) > bound) return bound + 1;
+    const std::size_t width = b.size() + 1;
+    rows.assign(3 * width, 0);
+    std::size_t* before = rows.data();       // Row i - 2
+    std::size_t* previous = before + width;  // Row i - 1
+    std::size_t* current = previous + width; // Row i
+    for (std::size_t j = 0; j < width; ++j) previous[j] = j;
+
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        current[0] = i;
+        std::size_t best = current[0];
+        for (std::size_t j = 1; j < width; ++j) {
+            const char x = foldCase(a[i - 1]);
+            const bool same = x == foldCase(b[j - 1]);
+            std::size_t cost = std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + (same ? 0 : 1)});
+            if (i > 1 && j > 1 && x == foldCase(b[j - 2]) && foldCase(a[i - 2]) == foldCase(b[j - 1])) {
+                cost = std::min(cost, before[j - 2] + 1); // Swapped neighbours
+            }
+            current[j] = cost;
+            best = std::min(best, cost);
         }
+        if (best > bound) return bound + 1; // Every path through this row is already too expensive
+        std::size_t* recycled = before;
+        before = previous;
+        previous = current;
+        current = recycled;
     }
-    std::cout << "\n All contacts sorted by name within each city.\n";
+    return std::min(previous[b.size()], bound + 1);
 }
 
-// Sorting Contacts by Name
-void sortContactsByName(std::map<std::string, std::vector<Contact>>& cityGroups){
-    for (auto& [city, people] : cityGroups) {
-        std::sort(people.begin(), people.end(), [](const Contact& a, const Contact& b) {
-            return a.name < b.name;
+// Prefix index: ids kept in (case-insensitive) key order, so every key starting with a prefix sits in one range
+// found by two binary searches
+// - Adds go to a small unsorted tail that searches scan directly; once it outgrows kMaxPending, the next search
+//   sorts it and merges it into the run, so a bulk load pays for one sort and interactive adds stay O(1)
+class PrefixIndex {
+public:
+    void add(std::uint32_t id) { pending.push_back(id); }
+
+    // Calls fn(id) for up to `limit` keys starting with `prefix` (run order, then recent adds); returns how many
+    // keys match in total
+    template <typename KeyOf, typename Fn>
+    std::size_t find(std::string_view prefix, KeyOf&& keyOf, std::size_t limit, Fn&& fn) {
+        if (pending.size() > kMaxPending) settle(keyOf);
+
+        auto first = std::partition_point(sorted.begin(), sorted.end(), [&](std::uint32_t id) {
+            return comparePrefix(keyOf(id), prefix) < 0;
         });
+        auto last = std::partition_point(first, sorted.end(), [&](std::uint32_t id) {
+            return comparePrefix(keyOf(id), prefix) == 0;
+        });
+        std::size_t count = static_cast<std::size_t>(last - first);
+        for (auto it = first; it != last && limit > 0; ++it, --limit) fn(*it);
+
+        for (std::uint32_t id : pending) {
+            if (comparePrefix(keyOf(id), prefix) != 0) continue;
+            ++count;
+            if (limit > 0) {
+                fn(id);
+                --limit;
+            }
+        }
+        return count;
+    }
+
+private:
+    static constexpr std::size_t kMaxPending = 1024; // Longest tail a search will scan
+
+    template <typename KeyOf>
+    void settle(KeyOf&& keyOf) {
+        auto less = [&](std::uint32_t a, std::uint32_t b) { return compareFolded(keyOf(a), keyOf(b)) < 0; };
+        std::stable_sort(pending.begin(), pending.end(), less);
+        const auto run = static_cast<std::ptrdiff_t>(sorted.size());
+        sorted.insert(sorted.end(), pending.begin(), pending.end());
+        std::inplace_merge(sorted.begin(), sorted.begin() + run, sorted.end(), less);
+        pending.clear();
+    }
+
+    std::vector<std::uint32_t> sorted;  // In key order
+    std::vector<std::uint32_t> pending; // Added since the last merge, in insertion order
+};
+
+// Trigram index for typo-tolerant search: each key's case-folded trigrams (padded, so the start and end count)
+// map to posting lists of ids, kept up to date on every add
+// - A key within k edits of the query shares all but at most 4k of the query's trigrams (one edit touches up to
+//   four), so every match sits in at least one of any 4k + 1 of the query's lists; a search unions just the
+//   4k + 1 shortest lists, drops candidates missing too many of the query's other trigrams, and checks real
+//   edit distance on the rest, never touching the other keys
+// - A query with 4k or fewer distinct trigrams can match a key that shares none of them ("Xo" for "Jo"), so it
+//   checks every key whose length is within k of its own instead (ids are also bucketed by key length)
+class GramIndex {
+public:
+    static constexpr std::size_t kTrigramsPerEdit = 4;
+
+    void add(std::uint32_t id, std::string_view key) {
+        forEachGram(key, [&](std::uint32_t gram) {
+            std::vector<std::uint32_t>& list = postings[gram];
+            if (list.empty() || list.back() != id) list.push_back(id); // A key repeating a trigram lists once
+        });
+        if (key.size() >= byLength.size()) byLength.resize(key.size() + 1);
+        byLength[key.size()].push_back(id);
+    }
+
+    // Ids whose key is within `maxEdits` of `query`, closest first (ties by id), at most `limit`
+    template <typename KeyOf>
+    std::vector<std::uint32_t> find(std::string_view query, std::size_t maxEdits, std::size_t limit,
+                                    KeyOf&& keyOf) const {
+        static const std::vector<std::uint32_t> kNone;
+        std::vector<std::uint32_t> grams;
+        forEachGram(query, [&](std::uint32_t gram) { grams.push_back(gram); });
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+        std::vector<const std::vector<std::uint32_t>*> lists;
+        for (std::uint32_t gram : grams) {
+            auto found = postings.find(gram);
+            lists.push_back(found == postings.end() ? &kNone : &found->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+        const std::size_t slack = kTrigramsPerEdit * maxEdits;                   // Query trigrams a match may lack
+        const std::size_t needed = lists.size() > slack ? lists.size() - slack : 0; // ...and how many it must share
+        const bool byKeyLength = lists.size() <= slack; // A match may share no trigram at all
+        const std::size_t scanned = byKeyLength ? 0 : slack + 1;
+
+        std::vector<std::uint32_t> candidates; // With one copy per scanned list the id is in
+        for (std::size_t l = 0; l < scanned; ++l) {
+            candidates.insert(candidates.end(), lists[l]->begin(), lists[l]->end());
+        }
+        if (byKeyLength) {
+            const std::size_t shortest = query.size() > maxEdits ? query.size() - maxEdits : 0;
+            for (std::size_t length = shortest; length <= query.size() + maxEdits && length < byLength.size();
+                 ++length) {
+                candidates.insert(candidates.end(), byLength[length].begin(), byLength[length].end());
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        std::vector<std::pair<std::size_t, std::uint32_t>> matches; // (distance, id)
+        std::vector<std::size_t> rows;
+        for (auto run = candidates.begin(); run != candidates.end();) {
+            const std::uint32_t id = *run;
+            const auto runEnd = std::upper_bound(run, candidates.end(), id);
+            std::size_t shared = static_cast<std::size_t>(runEnd - run);
+            run = runEnd;
+
+            // Count filter before the (far costlier) edit distance: look the id up in the longer lists, which
+            // are sorted because ids only grow, until it has enough trigrams or can no longer get them
+            for (std::size_t l = scanned; l < lists.size() && shared < needed && shared + (lists.size() - l) >= needed;
+                 ++l) {
+                if (std::binary_search(lists[l]->begin(), lists[l]->end(), id)) ++shared;
+            }
+            if (shared < needed) continue;
+
+            const std::size_t distance = editDistance(keyOf(id), query, maxEdits, rows);
+            if (distance <= maxEdits) matches.emplace_back(distance, id);
+        }
+        std::sort(matches.begin(), matches.end());
+        if (matches.size() > limit) matches.resize(limit);
+
+        std::vector<std::uint32_t> ids;
+        ids.reserve(matches.size());
+        for (const auto& match : matches) ids.push_back(match.second);
+        return ids;
+    }
+
+private:
+    // Trigrams of "\1\1" + folded key + "\2", packed into the low 24 bits
+    template <typename Fn>
+    static void forEachGram(std::string_view key, Fn&& fn) {
+        std::uint32_t window = (1u << 8) | 1u;
+        for (char c : key) {
+            window = ((window << 8) | static_cast<unsigned char>(foldCase(c))) & 0xFFFFFFu;
+            fn(window);
+        }
+        fn(((window << 8) | 2u) & 0xFFFFFFu);
+    }
+
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> postings;
+    std::vector<std::vector<std::uint32_t>> byLength; // Key length → ids (short queries only)
+};
+
+// Contact store laid out as a struct of arrays
+// - Names and phones live back to back in one character buffer; each contact keeps only (offset, length)
+// - Indices and character offsets are 32-bit; add() refuses a contact that would overflow them (hasRoom)
+// - Cities are interned: each contact stores a 4-byte city id, and every city keeps its contacts in display
+//   order, so counting a city is O(1) and listing it touches only its own contacts
+// - The (name, phone) dedupe index is a flat open-addressing table of contact indices with cached hashes,
+//   so a duplicate check is one hash and usually one probe instead of a walk down a tree of string pairs
+// - Name order is kept as a sorted run plus the contacts added since the last sort, so re-sorting only sorts
+//   the new tail and merges it in (and sorting an unchanged book is free)
+// - Names and cities are searchable by prefix (PrefixIndex) and with typos (GramIndex); both follow every add
+class ContactStore {
+public:
+    using Index = std::uint32_t;
+    using CityId = std::uint32_t;
+
+    struct Text {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    // Make room for `contacts` more (bulk imports; capacity still at least doubles, so batch after batch stays cheap)
+    void reserve(std::size_t contacts) {
+        makeRoom(names, contacts);
+        makeRoom(phones, contacts);
+        makeRoom(cityOf, contacts);
+        makeRoom(identityHash, contacts);
+        makeRoom(order, contacts);
+        growIndex(size() + contacts);
+    }
+
+    // True if one more contact with this name and phone still fits the 32-bit indices and text offsets
+    bool hasRoom(std::string_view name, std::string_view phone) const {
+        return size() < kEmpty && name.size() + phone.size() <= kMaxCharacters - characters.size();
+    }
+
+    // Adds a contact; false if (name, phone) is already stored, or if the store has no room for it (see hasRoom)
+    bool add(std::string_view name, std::string_view phone, std::string_view city) {
+        if (!hasRoom(name, phone)) return false;
+        growIndex(size() + 1);
+        const std::uint64_t hash = identityOf(name, phone);
+        std::size_t slot = hash & (slots.size() - 1);
+        for (; slots[slot] != kEmpty; slot = (slot + 1) & (slots.size() - 1)) {
+            const Index other = slots[slot];
+            if (identityHash[other] == hash && nameOf(other) == name && phoneOf(other) == phone) return false;
+        }
+
+        const auto index = static_cast<Index>(size());
+        slots[slot] = index;
+        names.push_back(store(name));
+        phones.push_back(store(phone));
+        cityOf.push_back(intern(city));
+        identityHash.push_back(hash);
+        std::vector<Index>& members = cityMembers[cityOf.back()];
+        if (members.size() == cityDue[cityOf.back()]) unsortedCities.push_back(cityOf.back()); // First since the sort
+        members.push_back(index);
+        order.push_back(index); // Joins the unsorted tail (here and in its city)
+        namePrefix.add(index);
+        nameGrams.add(index, name);
+        return true;
+    }
+
+    std::size_t size() const { return cityOf.size(); }
+    std::size_t cityCount() const { return cityNames.size(); }
+
+    std::string_view nameOf(Index i) const { return view(names[i]); }
+    std::string_view phoneOf(Index i) const { return view(phones[i]); }
+    std::string_view cityName(CityId id) const { return cityNames[id]; }
+    CityId cityOfContact(Index i) const { return cityOf[i]; }
+
+    // City id for `city`, or false if no contact lives there
+    bool findCity(std::string_view city, CityId& id) const {
+        auto found = cityIds.find(std::string(city));
+        if (found == cityIds.end()) return false;
+        id = found->second;
+        return true;
+    }
+
+    // Contacts in `city`, O(1): a hash lookup and a list size
+    std::size_t countCity(std::string_view city) const {
+        CityId id;
+        return findCity(city, id) ? cityMembers[id].size() : 0;
+    }
+
+    // Contacts whose name starts with `prefix` (any case): calls fn(index) for up to `limit`, returns the total
+    template <typename Fn>
+    std::size_t findNames(std::string_view prefix, std::size_t limit, Fn&& fn) {
+        return namePrefix.find(prefix, [this](Index i) { return nameOf(i); }, limit, fn);
+    }
+
+    // Cities whose name starts with `prefix` (any case), like findNames
+    template <typename Fn>
+    std::size_t findCities(std::string_view prefix, std::size_t limit, Fn&& fn) {
+        return cityPrefix.find(prefix, [this](CityId id) { return cityName(id); }, limit, fn);
+    }
+
+    // Contacts whose name is a few typos away from `query`, closest first
+    std::vector<Index> fuzzyNames(std::string_view query, std::size_t limit) const {
+        return nameGrams.find(query, typoBudget(query), limit, [this](Index i) { return nameOf(i); });
+    }
+
+    // Cities a few typos away from `query`, closest first
+    std::vector<CityId> fuzzyCities(std::string_view query, std::size_t limit) const {
+        return cityGrams.find(query, typoBudget(query), limit, [this](CityId id) { return cityName(id); });
+    }
+
+    // Cities in name order, each with its contacts in display order
+    template <typename Fn>
+    void forEachCity(Fn&& fn) const {
+        std::vector<CityId> cities(cityNames.size());
+        std::iota(cities.begin(), cities.end(), 0);
+        std::sort(cities.begin(), cities.end(), [&](CityId a, CityId b) { return cityNames[a] < cityNames[b]; });
+
+        for (CityId id : cities) {
+            const std::vector<Index>& members = settleCity(id);
+            fn(id, members.data(), members.data() + members.size());
+        }
+    }
+
+    // Contacts in `city` in display order: O(contacts in that city)
+    template <typename Fn>
+    void forEachInCity(CityId id, Fn&& fn) const {
+        for (Index i : settleCity(id)) fn(i);
+    }
+
+    // Puts every contact in name order (stable, so equal names keep their order)
+    // - Only the contacts added since the last sort are sorted, then merged into the sorted run: O(k log k + n)
+    // - Until the next sort, new contacts show after the sorted run in the order they were added
+    // - Each city's list gets the same sort and merge, but only once that city is next listed (settleCity)
+    void sortByName() {
+        if (sortedRun == order.size()) return; // Nothing added since the last sort
+
+        for (CityId id : unsortedCities) cityDue[id] = cityMembers[id].size();
+        unsortedCities.clear();
+
+        auto byName = [this](Index a, Index b) { return nameOf(a) < nameOf(b); };
+        const auto tail = order.begin() + static_cast<std::ptrdiff_t>(sortedRun);
+#if defined(CONTACTS_PARALLEL) && defined(__cpp_lib_execution)
+        // Big batches (bulk loads) sort and merge in parallel; the comparator only reads, so this is safe
+        if (order.size() - sortedRun >= kParallelSortMin) {
+            std::stable_sort(std::execution::par_unseq, tail, order.end(), byName);
+            std::inplace_merge(std::execution::par_unseq, order.begin(), tail, order.end(), byName);
+            sortedRun = order.size();
+            return;
+        }
+#endif
+        std::stable_sort(tail, order.end(), byName);
+        std::inplace_merge(order.begin(), tail, order.end(), byName);
+        sortedRun = order.size();
+    }
+
+private:
+    static constexpr Index kEmpty = 0xFFFFFFFFu; // Also caps the contact count, so every index stays below it
+    static constexpr std::size_t kMaxCharacters = 0xFFFFFFFFu; // Text offsets and lengths are 32-bit
+    static constexpr std::size_t kParallelSortMin = 1 << 16; // Below this, threads cost more than they save
+
+    // One typo; two for long queries (12+ characters), where 9 trigram lists still leave the rarest ones to scan
+    static std::size_t typoBudget(std::string_view query) { return query.size() >= 12 ? 2 : 1; }
+
+    // FNV-1a over name, a separator, then phone
+    static std::uint64_t identityOf(std::string_view name, std::string_view phone) {
+        std::uint64_t hash = 1469598103934665603ull;
+        auto mix = [&](std::string_view text) {
+            for (char c : text) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+        };
+        mix(name);
+        hash ^= 0xFF; // Keeps ("ab", "c") apart from ("a", "bc")
+        hash *= 1099511628211ull;
+        mix(phone);
+        return hash;
+    }
+
+    Text store(std::string_view text) {
+        const Text ref{static_cast<std::uint32_t>(characters.size()), static_cast<std::uint32_t>(text.size())};
+        characters.append(text);
+        return ref;
+    }
+
+    std::string_view view(Text ref) const { return std::string_view(characters).substr(ref.offset, ref.length); }
+
+    // Brings a city's list up to the last sortByName: its members up to cityDue are sorted and merged into
+    // the sorted run like the display order's tail was; later members stay in insertion order
+    const std::vector<Index>& settleCity(CityId id) const {
+        std::vector<Index>& members = cityMembers[id];
+        if (citySorted[id] < cityDue[id]) {
+            auto byName = [this](Index a, Index b) { return nameOf(a) < nameOf(b); };
+            const auto tail = members.begin() + static_cast<std::ptrdiff_t>(citySorted[id]);
+            const auto due = members.begin() + static_cast<std::ptrdiff_t>(cityDue[id]);
+            std::stable_sort(tail, due, byName);
+            std::inplace_merge(members.begin(), tail, due, byName);
+            citySorted[id] = cityDue[id];
+        }
+        return members;
+    }
+
+    CityId intern(std::string_view city) {
+        auto [found, inserted] = cityIds.try_emplace(std::string(city), static_cast<CityId>(cityNames.size()));
+        if (inserted) {
+            cityNames.emplace_back(city);
+            cityMembers.emplace_back();
+            citySorted.push_back(0);
+            cityDue.push_back(0);
+            cityPrefix.add(found->second);
+            cityGrams.add(found->second, city);
+        }
+        return found->second;
     }
+
+    template <typename T>
+    static void makeRoom(std::vector<T>& column, std::size_t extra) {
+        const std::size_t needed = column.size() + extra;
+        if (needed > column.capacity()) column.reserve(std::max(needed, column.capacity() * 2));
+    }
+
+    // Keeps the table at most half full (power-of-two size, so a probe step is a mask)
+    void growIndex(std::size_t contacts) {
+        if (contacts * 2 <= slots.size()) return;
+        std::size_t capacity = slots.empty() ? 16 : slots.size();
+        while (capacity < contacts * 2) capacity *= 2;
+        slots.assign(capacity, kEmpty);
+        rebuildIndex();
+    }
+
+    void rebuildIndex() {
+        std::fill(slots.begin(), slots.end(), kEmpty);
+        for (Index i = 0; i < size(); ++i) {
+            std::size_t slot = identityHash[i] & (slots.size() - 1);
+            while (slots[slot] != kEmpty) slot = (slot + 1) & (slots.size() - 1);
+            slots[slot] = i;
+        }
+    }
+
+    // Columns, one entry per contact
+    std::vector<Text> names;
+    std::vector<Text> phones;
+    std::vector<CityId> cityOf;
+    std::vector<std::uint64_t> identityHash;
+
+    std::string characters; // Every name and phone, back to back
+
+    // Interned cities
+    std::vector<std::string> cityNames;
+    std::unordered_map<std::string, CityId> cityIds;
+    // City → its contacts: [0, citySorted) in name order, [citySorted, cityDue) sorted by the last sortByName
+    // but not merged yet (settleCity), the rest in insertion order. Listing a city settles it, hence mutable
+    mutable std::vector<std::vector<Index>> cityMembers;
+    mutable std::vector<std::size_t> citySorted;
+    std::vector<std::size_t> cityDue;     // City → members the last sortByName covered
+    std::vector<CityId> unsortedCities;   // Cities with members added since the last sortByName
+
+    // Search indexes
+    PrefixIndex namePrefix;
+    PrefixIndex cityPrefix;
+    GramIndex nameGrams;
+    GramIndex cityGrams;
+
+    std::vector<Index> slots; // Dedupe index: contact index or kEmpty
+
+    // Display order: order[0, sortedRun) is sorted by name, the rest is in insertion order
+    std::vector<Index> order;
+    std::size_t sortedRun = 0;
+};
+
+// Displaying all Contacts
+void displayAllContacts(const ContactStore& contacts){
+    contacts.forEachCity([&](ContactStore::CityId city, const ContactStore::Index* first,
+                             const ContactStore::Index* last) {
+        std::cout << "\n\U0001f3d9️ " << contacts.cityName(city) << ":\n";
+        for (; first != last; ++first) {
+            std::cout << "- " << contacts.nameOf(*first) << " (" << contacts.phoneOf(*first) << ")\n";
+        }
+    });
+    std::cout << "\n All contacts sorted by name within each city.\n";
+}
+
+// Sorting Contacts by Name
+void sortContactsByName(ContactStore& contacts){
+    contacts.sortByName();
     std::cout << "\n All contacts sorted by name within each city.\n";
 }
 
+// Suggesting cities for a search with no exact match: ones starting with it, else ones a typo or two away
+void suggestCities(ContactStore& contacts, const std::string& query) {
+    std::vector<ContactStore::CityId> cities;
+    contacts.findCities(query, 5, [&](ContactStore::CityId city) { cities.push_back(city); });
+    if (cities.empty()) cities = contacts.fuzzyCities(query, 5);
+    if (cities.empty()) return;
+
+    std::cout << "Did you mean:";
+    for (ContactStore::CityId city : cities) std::cout << " " << contacts.cityName(city);
+    std::cout << "\n";
+}
+
 // Searching by City
-void searchCity(std::map<std::string, std::vector<Contact>>& cityGroups){
+void searchCity(ContactStore& contacts){
     std::string searchCity;
     std::cout << "Enter city to search: ";
     std::cin >> searchCity;
 
-    if (cityGroups.count(searchCity)) {
+    ContactStore::CityId city;
+    if (contacts.findCity(searchCity, city)) {
         std::cout << "\n\U0001f50e People in " << searchCity << ":\n";
-        for (const auto& person : cityGroups.at(searchCity)) {
-            std::cout << "- " << person.name << " (" << person.phone << ")\n";
-        }
+        contacts.forEachInCity(city, [&](ContactStore::Index person) {
+            std::cout << "- " << contacts.nameOf(person) << " (" << contacts.phoneOf(person) << ")\n";
+        });
     } else {
         std::cout << "⚠️ No contacts in this city.\n";
+        suggestCities(contacts, searchCity);
     }
 
 }
 
 // Counting by City
-void countCity(const std::map<std::string, std::vector<Contact>>& cityGroups) {
+void countCity(const ContactStore& contacts) {
     std::string targetCity;
     std::cout << "Count in city: ";
     std::cin >> targetCity;
 
-    int count = cityGroups.count(targetCity) ? cityGroups.at(targetCity).size() : 0;
+    std::size_t count = contacts.countCity(targetCity);
     std::cout << "Total contacts in " << targetCity << ": " << count << "\n";
 }
 
-int main(){
+// Finding by Name: every name starting with the query, or the closest names if none does
+void findName(ContactStore& contacts) {
+    std::string query;
+    std::cout << "Name starts with: ";
+    std::cin >> query;
+
+    constexpr std::size_t kShown = 10;
+    auto show = [&](ContactStore::Index person) {
+        std::cout << "- " << contacts.nameOf(person) << " (" << contacts.phoneOf(person) << ") in "
+                  << contacts.cityName(contacts.cityOfContact(person)) << "\n";
+    };
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<ContactStore::Index> found;
+    std::size_t total = contacts.findNames(query, kShown, [&](ContactStore::Index person) { found.push_back(person); });
+    const bool fuzzy = total == 0;
+    if (fuzzy) found = contacts.fuzzyNames(query, kShown);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - started;
+
+    if (found.empty()) {
+        std::cout << "⚠️ No names like " << query << ".\n";
+        return;
+    }
+    std::cout << "\n\U0001f50e " << (fuzzy ? "Close matches for " : "Names starting with ") << query << " ("
+              << elapsed.count() << " µs):\n";
+    for (ContactStore::Index person : found) show(person);
+    if (total > found.size()) std::cout << "... and " << total - found.size() << " more\n";
+}
+
+// Importing from CSV (name,phone,city): rows arrive a chunk at a time, so the store grows and dedupes once per batch
+bool importContacts(ContactStore& contacts, const std::string& path) {
+    auto started = std::chrono::steady_clock::now();
+    std::size_t added = 0;
+    bool full = false;
+    csv::ReadStats stats;
+    const bool ok = csv::readRows<3>(path, [&](const std::vector<std::array<std::string_view, 3>>& rows) {
+        if (full) return;
+        contacts.reserve(rows.size());
+        for (const auto& row : rows) {
+            if (!contacts.hasRoom(row[0], row[1])) {
+                full = true;
+                return;
+            }
+            added += contacts.add(row[0], row[1], row[2]);
+        }
+    }, stats);
+    if (!ok) {
+        std::cout << "❌ Could not read " << path << "\n";
+        return false;
+    }
+    if (full) {
+        std::cout << "❌ " << path << " does not fit the contact book: stopped after " << added << " contacts\n";
+        return false;
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - started;
+    std::cout << "✅ Imported " << added << " contacts from " << path << " (" << stats.rows - added
+              << " duplicates, " << stats.skipped << " malformed lines) in " << elapsed.count() << " ms\n";
+    return true;
+}
+
+// Exporting to CSV, grouped by city in display order (the same layout importContacts reads)
+bool exportContacts(const ContactStore& contacts, const std::string& path) {
+    csv::Writer out;
+    if (!out.open(path)) {
+        std::cout << "❌ Could not write " << path << "\n";
+        return false;
+    }
+    out.row({"name", "phone", "city"});
+    contacts.forEachCity([&](ContactStore::CityId city, const ContactStore::Index* first,
+                             const ContactStore::Index* last) {
+        for (; first != last; ++first) {
+            out.row({contacts.nameOf(*first), contacts.phoneOf(*first), contacts.cityName(city)});
+        }
+    });
+    if (!out.close()) {
+        std::cout << "❌ Could not write " << path << "\n";
+        return false;
+    }
+    std::cout << "✅ Exported " << contacts.size() << " contacts to " << path << "\n";
+    return true;
+}
+
+// Bulk load fixture: ./main --load N adds N synthetic contacts (every 10th a duplicate) and times the load,
+// a round of countCity lookups and sorting
+void loadFixture(ContactStore& contacts, std::size_t count) {
+    contacts.reserve(count);
+
+    auto started = std::chrono::steady_clock::now();
+    std::size_t added = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t id = i % 10 == 9 ? i - 1 : i; // Repeat the previous identity
+        added += contacts.add("Name" + std::to_string(id), "555" + std::to_string(id),
+                              "City" + std::to_string(id % 1000));
+    }
+    auto loaded = std::chrono::steady_clock::now();
+
+    std::size_t total = 0;
+    for (int round = 0; round < 1000; ++round) total += contacts.countCity("City" + std::to_string(round));
+    auto counted = std::chrono::steady_clock::now();
+
+    contacts.sortByName(); // Full sort of the whole book
+    auto sorted = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 1000; ++i) {
+        contacts.add("Late" + std::to_string(i), "556" + std::to_string(i), "City" + std::to_string(i));
+    }
+    auto appended = std::chrono::steady_clock::now();
+    contacts.sortByName(); // Sorts the 1000 new contacts and merges them in
+    auto resorted = std::chrono::steady_clock::now();
+
+    std::size_t matches = contacts.findNames("Name1", 0, [](ContactStore::Index) {}); // Builds the prefix run
+    auto indexed = std::chrono::steady_clock::now();
+    for (int round = 0; round < 1000; ++round) {
+        matches += contacts.findNames("name" + std::to_string(round * 997), 10, [](ContactStore::Index) {});
+    }
+    auto prefixed = std::chrono::steady_clock::now();
+    std::size_t close = 0;
+    for (int round = 0; round < 1000; ++round) {
+        std::string typo = "Name" + std::to_string(round * 997);
+        std::swap(typo[1], typo[2]); // "Nmae..."
+        close += contacts.fuzzyNames(typo, 10).size();
+    }
+    auto fuzzed = std::chrono::steady_clock::now();
+
+    // Short names share few or no trigrams with a one-letter typo of themselves, so they take the by-length path
+    constexpr std::string_view kShortNames[][2] = {{"Jo", "Xo"}, {"Al", "Bl"}, {"Eve", "Ave"}, {"Ann", "Anm"}};
+    std::size_t shortFound = 0;
+    for (const auto& [name, typo] : kShortNames) {
+        contacts.add(name, "557", "City0");
+        for (ContactStore::Index person : contacts.fuzzyNames(typo, 10)) shortFound += contacts.nameOf(person) == name;
+    }
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::cout << "Loaded " << added << " contacts (" << count - added << " duplicates) into "
+              << contacts.cityCount() << " cities in " << Ms(loaded - started).count() << " ms\n";
+    std::cout << "1000 countCity lookups (" << total << " contacts) in " << Ms(counted - loaded).count() << " ms\n";
+    std::cout << "Sort by name: " << Ms(sorted - counted).count() << " ms; after 1000 more adds: "
+              << Ms(resorted - appended).count() << " ms\n";
+    std::cout << "Prefix index merge: " << Ms(indexed - resorted).count() << " ms; 1000 prefix searches ("
+              << matches << " matches) in " << Ms(prefixed - indexed).count() << " ms; 1000 typo searches ("
+              << close << " matches) in " << Ms(fuzzed - prefixed).count() << " ms\n";
+    std::cout << (shortFound == std::size(kShortNames) ? "✅" : "❌") << " Short typo searches: " << shortFound << "/"
+              << std::size(kShortNames) << " found\n";
+}
+
+int main(int argc, char* argv[]){
     // Declare Data Structures
-    std::map<std::string, std::vector<Contact>>cityGroups; // We group ppl by city
-    std::set<std::pair<std::string, std::string>>seen; // seen helps prevent duplicate entries (name, phone pair)
+    ContactStore contacts; // Columns grouped by interned city id; the store also rejects duplicate (name, phone)
+
+    // Batch mode: --load N (synthetic fixture), --import FILE (pre-fill), --export FILE (write and exit)
+    std::size_t fixture = 0;
+    std::string importPath, exportPath;
+    for (int i = 1; i < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (flag != "--load" && flag != "--import" && flag != "--export") {
+            std::cout << "❌ Unknown option " << flag << "\n";
+            return 1;
+        }
+        if (i + 1 == argc) {
+            std::cout << "❌ Missing value for " << flag << "\n";
+            return 1;
+        }
+        if (flag == "--load") fixture = static_cast<std::size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+        else if (flag == "--import") importPath = argv[i + 1];
+        else exportPath = argv[i + 1];
+    }
+    if (fixture > 0) loadFixture(contacts, fixture);
+    if (!importPath.empty() && !importContacts(contacts, importPath)) return 1;
+    if (!exportPath.empty()) return exportContacts(contacts, exportPath) ? 0 : 1;
+    if (fixture > 0) return 0;
 
     while(true){
-        std::cout << "\n[1] Add Contact\n[2] Show All\n[3] Sort by Name\n[4] Search City\n[5] Count City\n[6] Exit\n> ";
+        std::cout << "\n[1] Add Contact\n[2] Show All\n[3] Sort by Name\n[4] Search City\n[5] Count City\n[6] Exit\n"
+                     "[7] Find Name\n> ";
         int choice;
         if (!(std::cin >> choice)) {
             std::cout << "❌ Invalid input. Exiting...\n";
@@ -79,36 +727,36 @@ int main(){
             std::cout << "Enter phone: "; std::cin >> phone;
             std::cout << "Enter city: "; std::cin >> city;
 
-            // Prevent duplicates using seen set
-            std::pair<std::string, std::string> identity = {name, phone};
-            if (seen.count(identity) == 0) {
-                cityGroups[city].push_back(Contact{name, phone, city});
-                seen.insert(identity);
+            // Prevent duplicates using the store's (name, phone) index
+            if (!contacts.hasRoom(name, phone)) {
+                std::cout << "❌ The contact book is full.\n";
+            } else if (contacts.add(name, phone, city)) {
                 std::cout << "✅ Contact added!\n";
             } else {
                 std::cout << "⚠️ Contact already exists.\n";
             }
         }else if(choice == 2){
             std::cout << "Displaying Contacts (by City)...";
-            displayAllContacts(cityGroups);
+            displayAllContacts(contacts);
         }else if(choice == 3){
             std::cout << "Sorting Contacts by Name....\n";
-            sortContactsByName(cityGroups);
-            displayAllContacts(cityGroups);
+            sortContactsByName(contacts);
+            displayAllContacts(contacts);
         }else if(choice == 4){
             std::cout << "Searching Contacts by City....";
-            searchCity(cityGroups);
+            searchCity(contacts);
         }else if(choice == 5){
             std::cout << "Counting Ppl by City....";
-            countCity(cityGroups);
+            countCity(contacts);
         }else if(choice == 6){
             std::cout << "Exiting Contact Group Manager++...\n";
             break;
+        }else if(choice == 7){
+            std::cout << "Finding Contacts by Name....";
+            findName(contacts);
         }else {
             std::cout << "Invalid Option.\n";
         }
     }
     return 0;
 }
-
-
@@ -0,0 +1,45 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm> // For std::clamp
+#include <chrono>    // Interval arithmetic
+
+// 🎚️ Adaptive sampling interval for the polling fallback
+//    - Stable samples back off exponentially toward `maxInterval` (long focus blocks cost few wakeups)
+//    - A switch snaps the interval down to a quarter of the recent gap between switches, so bursts of
+//      context switching are sampled at up to `minInterval`
+class AdaptiveInterval {
+public:
+    using Millis = std::chrono::milliseconds;
+
+    AdaptiveInterval(Millis minInterval, Millis maxInterval, double backoff = 2.0)
+        : minimum(minInterval), maximum(std::max(minInterval, maxInterval)), growth(backoff), interval(minInterval),
+          recentGap(maxInterval) {}
+
+    // ⏭ Feeds one sample's outcome and returns how long to wait before the next one
+    Millis next(bool switched, Millis sinceLastSwitch) {
+        if (switched) {
+            // EWMA of the gap between switches (α = 0.5 reacts within a couple of switches)
+            recentGap = Millis((recentGap.count() + sinceLastSwitch.count()) / 2);
+            interval = std::clamp(Millis(recentGap.count() / 4), minimum, maximum);
+        } else {
+            interval = std::clamp(Millis(static_cast<Millis::rep>(static_cast<double>(interval.count()) * growth)),
+                                  minimum, maximum);
+        }
+        return interval;
+    }
+
+    Millis current() const { return interval; }
+
+    // 📈 Effective sampling rate at the current interval
+    double samplesPerHour() const {
+        return interval.count() > 0 ? 3600000.0 / static_cast<double>(interval.count()) : 0.0;
+    }
+
+private:
+    Millis minimum;
+    Millis maximum;
+    double growth;
+    Millis interval;
+    Millis recentGap;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <atomic>        // For publishing new ids to reader threads
+#include <cstdint>       // For std::uint32_t
+#include <string>        // Interned names
+#include <string_view>   // Lookup keys without copying
+#include <unordered_map> // Key → id lookup (only touched on first sight of an app)
+#include <vector>        // Dense id → name table
+
+// 🆔 Dense identifier for an interned application (index into flat session tables)
+using AppId = std::uint32_t;
+
+// 📇 App-name intern table: maps a bundle identifier (or display name) to a dense AppId once
+//    - Writer: the observer thread only (intern)
+//    - Readers: any thread (nameOf / size); names are never moved, so reads need no lock
+class AppRegistry {
+public:
+    static constexpr AppId kUnknown = 0;          // Reserved for apps without a name, and for overflow
+    static constexpr std::size_t kMaxApps = 4096; // Capacity reserved up front so the table never reallocates
+
+    AppRegistry() {
+        names.reserve(kMaxApps);
+        keys.reserve(kMaxApps);
+        names.emplace_back("Unknown");
+        keys.emplace_back();
+        published.store(1, std::memory_order_release);
+    }
+
+    // ➕ Returns the id for `key`, registering it with `displayName` on first sight (observer thread only)
+    AppId intern(std::string_view key, std::string_view displayName) {
+        if (key.empty()) return kUnknown;
+
+        auto found = ids.find(std::string(key));
+        if (found != ids.end()) return found->second;
+
+        if (names.size() == kMaxApps) return kUnknown; // Table full: fold into Unknown rather than reallocate
+
+        const auto id = static_cast<AppId>(names.size());
+        names.emplace_back(displayName.empty() ? key : displayName);
+        keys.emplace_back(key);
+        ids.emplace(std::string(key), id);
+        published.store(names.size(), std::memory_order_release); // Make the new name visible to readers
+        return id;
+    }
+
+    // 🏷️ Display name for `id` (safe from any thread for ids it has received)
+    const std::string& nameOf(AppId id) const {
+        return id < published.load(std::memory_order_acquire) ? names[id] : names[kUnknown];
+    }
+
+    // 🔑 Key `id` was interned under (empty for kUnknown); same thread rules as nameOf
+    const std::string& keyOf(AppId id) const {
+        return id < published.load(std::memory_order_acquire) ? keys[id] : keys[kUnknown];
+    }
+
+    // 🔢 Number of ids handed out so far (including kUnknown)
+    std::size_t size() const { return published.load(std::memory_order_acquire); }
+
+private:
+    std::unordered_map<std::string, AppId> ids; // Key → id (writer thread only)
+    std::vector<std::string> names;             // Id → display name (reserved; never reallocates)
+    std::vector<std::string> keys;              // Id → intern key (reserved; never reallocates)
+    std::atomic<std::size_t> published{0};      // Ids < published are readable
+};
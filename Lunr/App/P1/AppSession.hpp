@@ -0,0 +1,37 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <chrono>      // For time tracking
+#include <cstddef>     // For offsetof
+#include <type_traits> // For the trivially-copyable checks
+
+#include "AppRegistry.hpp"    // AppId
+#include "FocusHistogram.hpp" // Constant-size focus duration history
+#include "UsageCategory.hpp"  // Category carried on each event
+
+// ⏱ Aliases for cleaner chrono usage
+using Clock = std::chrono::system_clock;
+using Seconds = std::chrono::seconds;
+
+// 🗃️ Structure to hold session data for each app (POD: cheap to copy and serialize)
+struct AppSession {
+    AppId app = AppRegistry::kUnknown;             // Interned application id
+    UsageCategory category = UsageCategory::Other; // From its SwitchEvents (fits in the padding after `app`)
+    Clock::time_point startTime;                   // Start time of the current session
+    Seconds totalDuration = Seconds(0);            // Total accumulated time used
+    FocusHistogram focusHistogram;                 // Distribution of focus durations (time between switches)
+    RecentFocus<16> recentFocus;                   // Last 16 raw focus durations, newest first
+};
+
+// 📨 Compact record of one closed focus session (what the observer hands the analyzer)
+struct SwitchEvent {
+    AppId app = AppRegistry::kUnknown;             // App that held focus
+    UsageCategory category = UsageCategory::Other; // Its category (fits in the padding after `app`)
+    Clock::time_point startTime;                   // When it gained focus
+    Seconds duration = Seconds(0);                 // How long it kept focus
+};
+
+static_assert(std::is_trivially_copyable_v<AppSession>, "AppSession must stay POD");
+static_assert(std::is_trivially_copyable_v<SwitchEvent>, "SwitchEvent must stay POD");
+static_assert(sizeof(SwitchEvent) == 24, "SwitchEvent should stay three words");
+static_assert(offsetof(AppSession, startTime) == 8, "AppSession::category must stay in the padding");
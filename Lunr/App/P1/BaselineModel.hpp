@@ -0,0 +1,146 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>   // For std::min
+#include <array>       // Fixed bucket table (no allocation, checkpointed verbatim)
+#include <chrono>      // Session times
+#include <cmath>       // For std::sqrt
+#include <cstdint>     // Fixed-width state
+#include <ctime>       // Local weekday / hour
+#include <type_traits> // For the trivially-copyable check
+
+#include "AppSession.hpp"    // Clock, Seconds
+#include "UsageCategory.hpp" // Category index
+
+// 📐 Expected use of one category in one hour-of-week bucket
+struct BaselineExpectation {
+    double mean = 0.0;         // Seconds per hour
+    double stdDev = 0.0;       // Seconds per hour
+    std::uint32_t samples = 0; // Hours folded into the bucket so far
+};
+
+// 🧭 Learned usage baseline: per category and per (weekday, hour) bucket, an exponentially weighted mean and
+//    variance of the seconds spent in that category during that hour
+//    - Online: each closed session only adds seconds to the open hour; when an hour closes, its totals (zeros
+//      included) are folded into that hour's buckets in O(categories). History is never rescanned
+//    - Hours the agent never observed are skipped rather than counted as zero use
+//    - Fixed size (~10 KB), trivially copyable: checkpointed verbatim next to the sessions
+//    - Lookups and deviation checks are O(1) regardless of how many months have been learned
+class BaselineModel {
+public:
+    static constexpr int kDays = 7;
+    static constexpr int kHours = 24;
+    static constexpr int kBuckets = kDays * kHours;
+    static constexpr float kAlpha = 0.2f;   // Weight of the newest week: roughly a five-week memory
+    static constexpr int kWarmupHours = 3;  // Samples a bucket needs before it can flag deviations
+
+    // ➕ Credits a closed session, split across every local hour it spans (analyzer thread)
+    void record(UsageCategory category, Clock::time_point start, Seconds duration) {
+        std::int64_t at = toEpoch(start);
+        std::int64_t remaining = duration.count();
+        while (remaining > 0) {
+            const HourSlot slot = hourOf(at);
+            advanceTo(slot);
+            const std::int64_t inHour = std::min<std::int64_t>(remaining, slot.endEpoch - at);
+            pending[index(category)] += static_cast<std::uint32_t>(inHour);
+            at += inHour;
+            remaining -= inHour;
+        }
+    }
+
+    // 📊 What the baseline expects for `category` in the hour containing `t`
+    BaselineExpectation expected(UsageCategory category, Clock::time_point t) const {
+        const Bucket& bucket = buckets[index(category)][hourOf(toEpoch(t)).bucket];
+        return {bucket.mean, std::sqrt(static_cast<double>(bucket.variance)), bucket.samples};
+    }
+
+    // 📊 expected() prorated to the part of t's hour that has passed: what a full-hour mean predicts by `t`
+    //    (mean and spread both scale linearly, as if the hour's use were spread evenly across it)
+    BaselineExpectation expectedSoFar(UsageCategory category, Clock::time_point t) const {
+        const std::int64_t epoch = toEpoch(t);
+        const HourSlot slot = hourOf(epoch);
+        const double elapsed = static_cast<double>(3600 - (slot.endEpoch - epoch)) / 3600.0;
+        const Bucket& bucket = buckets[index(category)][slot.bucket];
+        return {bucket.mean * elapsed, std::sqrt(static_cast<double>(bucket.variance)) * elapsed, bucket.samples};
+    }
+
+    // 📏 Standard score of `seconds` spent so far in the hour containing `t`, against expectedSoFar() (so a
+    //    partial hour is not judged against a full hour's mean); 0 while the bucket is still warming up
+    double zScore(UsageCategory category, Clock::time_point t, double seconds) const {
+        const BaselineExpectation e = expectedSoFar(category, t);
+        if (e.samples < kWarmupHours) return 0.0;
+        const double spread = e.stdDev > 60.0 ? e.stdDev : 60.0; // A one-minute floor keeps flat buckets sane
+        return (seconds - e.mean) / spread;
+    }
+
+    // ⏱️ Seconds credited to `category` in the hour containing `now` (the value to check with zScore()).
+    //    The open hour only advances when a session is recorded, so if it is not now's hour nothing is
+    //    credited to now's hour yet
+    std::uint32_t currentHourSeconds(UsageCategory category, Clock::time_point now) const {
+        return hourOf(toEpoch(now)).hourId == openHour ? pending[index(category)] : 0;
+    }
+
+private:
+    struct Bucket {
+        float mean = 0.0f;
+        float variance = 0.0f;
+        std::uint32_t samples = 0;
+    };
+
+    struct HourSlot {
+        std::int64_t hourId;   // Local hours since the epoch (identifies the open hour)
+        std::int64_t endEpoch; // When this hour ends
+        int bucket;            // weekday * 24 + hour
+    };
+
+    static std::size_t index(UsageCategory category) { return static_cast<std::size_t>(category); }
+
+    static std::int64_t toEpoch(Clock::time_point t) {
+        return std::chrono::duration_cast<Seconds>(t.time_since_epoch()).count();
+    }
+
+    static HourSlot hourOf(std::int64_t epoch) {
+        std::time_t t = static_cast<std::time_t>(epoch);
+        std::tm local{};
+        localtime_r(&t, &local);
+        const std::int64_t intoHour = local.tm_min * 60 + local.tm_sec;
+        const std::int64_t hourStart = epoch - intoHour;
+        return {(hourStart + local.tm_gmtoff) / 3600, hourStart + 3600, local.tm_wday * kHours + local.tm_hour};
+    }
+
+    // ⏭️ Closes the open hour (folding it into its buckets) when `slot` is a different hour
+    void advanceTo(const HourSlot& slot) {
+        if (slot.hourId == openHour) return;
+        if (openHour != kNoHour) fold();
+        openHour = slot.hourId;
+        openBucket = slot.bucket;
+    }
+
+    // 🧮 EWMA mean/variance update for every category (a zero is a real observation for a watched hour)
+    void fold() {
+        for (std::size_t c = 0; c < kCategoryCount; ++c) {
+            Bucket& bucket = buckets[c][openBucket];
+            const float x = static_cast<float>(pending[c]);
+            if (bucket.samples == 0) {
+                bucket.mean = x;
+                bucket.variance = 0.0f;
+            } else {
+                const float diff = x - bucket.mean;
+                const float step = kAlpha * diff;
+                bucket.mean += step;
+                bucket.variance = (1.0f - kAlpha) * (bucket.variance + diff * step);
+            }
+            ++bucket.samples;
+            pending[c] = 0;
+        }
+    }
+
+    static constexpr std::int64_t kNoHour = -1;
+
+    std::array<std::array<Bucket, kBuckets>, kCategoryCount> buckets{};
+    std::array<std::uint32_t, kCategoryCount> pending{}; // Seconds per category in the open hour
+    std::int64_t openHour = kNoHour;
+    int openBucket = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<BaselineModel>, "BaselineModel is checkpointed verbatim");
@@ -0,0 +1,68 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <cstdint>  // For fixed-width counters
+#include <cmath>    // For std::sqrt
+
+#include "AppSession.hpp" // Clock aliases, AppSession
+
+// 📈 Running behavior aggregates, updated once per closed focus session
+//    Every field is maintained incrementally, so a snapshot costs O(1) no matter how many apps or sessions exist
+struct BehaviorStats {
+    Seconds totalFocusTime = Seconds(0);  // Sum of all focus durations
+    std::uint64_t totalSwitches = 0;      // Number of closed focus sessions
+
+    AppId topApp = AppRegistry::kUnknown; // App with the largest accumulated time
+    Seconds topDuration = Seconds(0);     // Its accumulated time
+
+    double meanFocus = 0.0;               // Running mean of focus duration (seconds)
+    double focusM2 = 0.0;                 // Sum of squared deviations (Welford), for variance
+
+    // ➕ Folds one focus session of `duration` into the aggregates; `session` is the app's already-updated record
+    void record(const AppSession& session, Seconds duration) {
+        totalFocusTime += duration;
+        ++totalSwitches;
+
+        // Per-app totals only ever grow, so comparing the updated app against the current max keeps it exact
+        if (session.totalDuration > topDuration) {
+            topDuration = session.totalDuration;
+            topApp = session.app;
+        }
+
+        // Welford's online update: numerically stable mean/variance without revisiting history
+        const double x = static_cast<double>(duration.count());
+        const double delta = x - meanFocus;
+        meanFocus += delta / static_cast<double>(totalSwitches);
+        focusM2 += delta * (x - meanFocus);
+    }
+
+    // 🔗 Combines another partial aggregate into this one (Chan et al. parallel mean/variance)
+    //    The top app is not merged: ids from different partials are unrelated, so the caller re-derives it
+    void merge(const BehaviorStats& other) {
+        if (other.totalSwitches == 0) return;
+        if (totalSwitches == 0) {
+            const AppId keepTop = topApp;
+            const Seconds keepTopDuration = topDuration;
+            *this = other;
+            topApp = keepTop;
+            topDuration = keepTopDuration;
+            return;
+        }
+
+        const double n = static_cast<double>(totalSwitches);
+        const double m = static_cast<double>(other.totalSwitches);
+        const double delta = other.meanFocus - meanFocus;
+        meanFocus += delta * m / (n + m);
+        focusM2 += other.focusM2 + delta * delta * n * m / (n + m);
+
+        totalFocusTime += other.totalFocusTime;
+        totalSwitches += other.totalSwitches;
+    }
+
+    // 📊 Population variance / standard deviation of focus durations (seconds²/seconds)
+    double focusVariance() const { return totalSwitches > 1 ? focusM2 / static_cast<double>(totalSwitches) : 0.0; }
+    double focusStdDev() const { return std::sqrt(focusVariance()); }
+
+    // 🧩 Higher fragmentation = attention split across more, shorter sessions
+    double fragmentationIndex() const { return totalSwitches > 0 ? 100.0 / static_cast<double>(totalSwitches) : 0.0; }
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <array>         // Compile-time lookup table
+#include <cstdint>       // For fixed-width hash values
+#include <fstream>       // For loading user rules
+#include <string>        // Rule keys
+#include <string_view>   // Zero-copy lookups
+#include <unordered_map> // Runtime user overlay (touched once per new app)
+#include <vector>        // AppId → category cache
+
+#include "AppRegistry.hpp"   // AppId
+#include "UsageCategory.hpp" // Category enum and names
+
+namespace category_detail {
+
+struct KnownApp {
+    std::string_view key; // Bundle identifier or display name
+    UsageCategory category;
+};
+
+// 📋 Built-in classification table (bundle ids, then display names as they appear in text logs, then
+//    browser sites as produced by siteOf())
+inline constexpr KnownApp kKnownApps[] = {
+    {"com.microsoft.VSCode", UsageCategory::Productivity},
+    {"com.apple.dt.Xcode", UsageCategory::Productivity},
+    {"com.apple.Terminal", UsageCategory::Productivity},
+    {"com.googlecode.iterm2", UsageCategory::Productivity},
+    {"com.github.GitHubClient", UsageCategory::Productivity},
+    {"com.jetbrains.CLion", UsageCategory::Productivity},
+    {"notion.id", UsageCategory::Productivity},
+    {"md.obsidian", UsageCategory::Productivity},
+    {"com.apple.Preview", UsageCategory::Productivity},
+    {"com.apple.iWork.Pages", UsageCategory::Productivity},
+    {"com.microsoft.Word", UsageCategory::Productivity},
+    {"com.netflix.Netflix", UsageCategory::Entertainment},
+    {"com.hbo.hbonow", UsageCategory::Entertainment},
+    {"com.apple.TV", UsageCategory::Entertainment},
+    {"com.apple.Music", UsageCategory::Entertainment},
+    {"com.spotify.client", UsageCategory::Entertainment},
+    {"com.twitter.twitter-mac", UsageCategory::Social},
+    {"com.burbn.instagram", UsageCategory::Social},
+    {"com.hnc.Discord", UsageCategory::Social},
+    {"com.tinyspeck.slackmacgap", UsageCategory::Social},
+    {"com.valvesoftware.steam", UsageCategory::Games},
+    {"org.openemu.OpenEmu", UsageCategory::Games},
+    {"Code", UsageCategory::Productivity},
+    {"Xcode", UsageCategory::Productivity},
+    {"Terminal", UsageCategory::Productivity},
+    {"iTerm2", UsageCategory::Productivity},
+    {"GitHub Desktop", UsageCategory::Productivity},
+    {"Notion", UsageCategory::Productivity},
+    {"Obsidian", UsageCategory::Productivity},
+    {"Preview", UsageCategory::Productivity},
+    {"Netflix", UsageCategory::Entertainment},
+    {"HBO Max", UsageCategory::Entertainment},
+    {"TV", UsageCategory::Entertainment},
+    {"Music", UsageCategory::Entertainment},
+    {"Spotify", UsageCategory::Entertainment},
+    {"Twitter", UsageCategory::Social},
+    {"Instagram", UsageCategory::Social},
+    {"Discord", UsageCategory::Social},
+    {"Slack", UsageCategory::Social},
+    {"Steam", UsageCategory::Games},
+    {"OpenEmu", UsageCategory::Games},
+    {"github.com", UsageCategory::Productivity},
+    {"gitlab.com", UsageCategory::Productivity},
+    {"stackoverflow.com", UsageCategory::Productivity},
+    {"docs.google.com", UsageCategory::Productivity},
+    {"developer.apple.com", UsageCategory::Productivity},
+    {"youtube.com", UsageCategory::Entertainment},
+    {"netflix.com", UsageCategory::Entertainment},
+    {"max.com", UsageCategory::Entertainment},
+    {"play.max.com", UsageCategory::Entertainment},
+    {"twitch.tv", UsageCategory::Entertainment},
+    {"twitter.com", UsageCategory::Social},
+    {"x.com", UsageCategory::Social},
+    {"instagram.com", UsageCategory::Social},
+    {"reddit.com", UsageCategory::Social},
+};
+
+constexpr std::size_t kKnownCount = sizeof(kKnownApps) / sizeof(kKnownApps[0]);
+constexpr std::size_t kTableSize = 512; // Power of two, ~9× the key count so a collision-free seed is found fast
+
+constexpr std::uint32_t hash(std::string_view key, std::uint32_t seed) {
+    std::uint32_t h = 2166136261u ^ seed; // FNV-1a, seeded
+    for (char c : key) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+// 🧮 Searches (at compile time) for a seed that maps every known key to a distinct slot
+constexpr std::uint32_t findSeed() {
+    for (std::uint32_t seed = 1; seed < 4096; ++seed) {
+        std::array<bool, kTableSize> used{};
+        bool perfect = true;
+        for (const KnownApp& app : kKnownApps) {
+            const std::size_t slot = hash(app.key, seed) & (kTableSize - 1);
+            if (used[slot]) {
+                perfect = false;
+                break;
+            }
+            used[slot] = true;
+        }
+        if (perfect) return seed;
+    }
+    return 0;
+}
+
+constexpr std::uint32_t kSeed = findSeed();
+static_assert(kSeed != 0, "no perfect-hash seed found; grow kTableSize");
+
+// 🗃️ Slot → index into kKnownApps (-1 = empty)
+constexpr std::array<std::int8_t, kTableSize> buildTable() {
+    static_assert(kKnownCount < 128, "int8_t slots hold at most 127 entries");
+    std::array<std::int8_t, kTableSize> table{};
+    for (auto& slot : table) slot = -1;
+    for (std::size_t i = 0; i < kKnownCount; ++i) {
+        table[hash(kKnownApps[i].key, kSeed) & (kTableSize - 1)] = static_cast<std::int8_t>(i);
+    }
+    return table;
+}
+
+inline constexpr std::array<std::int8_t, kTableSize> kTable = buildTable();
+
+} // namespace category_detail
+
+// ⚡ Built-in lookup: one hash, one probe, one compare (usable in constant expressions)
+constexpr UsageCategory knownCategory(std::string_view key) {
+    const std::int8_t index = category_detail::kTable[category_detail::hash(key, category_detail::kSeed) &
+                                                      (category_detail::kTableSize - 1)];
+    if (index < 0 || category_detail::kKnownApps[index].key != key) return UsageCategory::Other;
+    return category_detail::kKnownApps[index].category;
+}
+
+static_assert(knownCategory("com.microsoft.VSCode") == UsageCategory::Productivity);
+static_assert(knownCategory("not.a.real.app") == UsageCategory::Other);
+
+// 🏷️ App → category classifier: user rules overlay the built-in table, and each AppId is classified
+//    once, so the per-switch cost is a vector index (observer thread only)
+class CategoryClassifier {
+public:
+    // ➕ User rule (overrides the built-in table for `key`, a bundle id or display name)
+    void addRule(std::string key, UsageCategory category) { userRules[std::move(key)] = category; }
+
+    // 📂 Loads "key=Category" lines (blank lines and '#' comments skipped); returns the rules added
+    std::size_t loadRules(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::size_t added = 0;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            const auto equals = line.rfind('=');
+            UsageCategory category;
+            if (equals == std::string::npos || !parseCategory(std::string_view(line).substr(equals + 1), category)) {
+                continue;
+            }
+            addRule(line.substr(0, equals), category);
+            ++added;
+        }
+        return added;
+    }
+
+    // 🔍 Classifies by bundle id first, then display name (user rules win over built-ins)
+    UsageCategory classify(std::string_view key, std::string_view displayName) const {
+        for (std::string_view candidate : {key, displayName}) {
+            if (candidate.empty()) continue;
+            if (!userRules.empty()) {
+                auto rule = userRules.find(std::string(candidate));
+                if (rule != userRules.end()) return rule->second;
+            }
+            UsageCategory known = knownCategory(candidate);
+            if (known != UsageCategory::Other) return known;
+        }
+        return UsageCategory::Other;
+    }
+
+    // 📝 Records the category for a freshly interned id
+    void assign(AppId id, std::string_view key, std::string_view displayName) {
+        if (id >= byApp.size()) byApp.resize(id + 1, UsageCategory::Other);
+        byApp[id] = classify(key, displayName);
+    }
+
+    // ♻️ Reinstates a category resolved by an earlier run (checkpoint restore)
+    void restore(AppId id, UsageCategory category) {
+        if (id >= byApp.size()) byApp.resize(id + 1, UsageCategory::Other);
+        byApp[id] = category;
+    }
+
+    // ⚡ Per-switch lookup
+    UsageCategory categoryOf(AppId id) const { return id < byApp.size() ? byApp[id] : UsageCategory::Other; }
+
+private:
+    std::unordered_map<std::string, UsageCategory> userRules; // Runtime overlay
+    std::vector<UsageCategory> byApp;                         // AppId → category
+};
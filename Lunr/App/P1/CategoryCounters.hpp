@@ -0,0 +1,64 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <array>   // Fixed counter table
+#include <atomic>  // Lock-free counters and sequence words
+#include <cstdint> // For std::uint64_t
+
+#include "UsageCategory.hpp" // Category enum
+
+// ⏲️ Per-category usage seconds as cache-line-padded atomics
+//    - Each category's line holds its own value and sequence word, so writers never share a cache line
+//    - Each category must have a single writer thread at a time (the observer, or one thread per category)
+//    - snapshot() is seqlock-style: it retries until no counter changed while it was reading, so readers see
+//      one consistent instant across all categories without ever blocking a writer
+class CategoryCounters {
+public:
+    using Snapshot = std::array<std::uint64_t, kCategoryCount>;
+
+    // ➕ Credits `seconds` to `category` (single writer per category)
+    void add(UsageCategory category, std::uint64_t seconds) {
+        Slot& slot = slots[static_cast<std::size_t>(category)];
+        const std::uint64_t seq = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(seq + 1, std::memory_order_relaxed); // Odd: update in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value.store(slot.value.load(std::memory_order_relaxed) + seconds, std::memory_order_relaxed);
+        slot.sequence.store(seq + 2, std::memory_order_release); // Even again: update published
+    }
+
+    // 🔍 Single counter (always individually consistent)
+    std::uint64_t value(UsageCategory category) const {
+        return slots[static_cast<std::size_t>(category)].value.load(std::memory_order_relaxed);
+    }
+
+    // 📸 Consistent view of every category at one instant
+    Snapshot snapshot() const {
+        Snapshot values{};
+        std::array<std::uint64_t, kCategoryCount> before{};
+        while (true) {
+            bool stable = true;
+            for (std::size_t i = 0; i < kCategoryCount; ++i) {
+                before[i] = slots[i].sequence.load(std::memory_order_acquire);
+                if (before[i] & 1) stable = false; // A writer is mid-update
+            }
+            if (!stable) continue;
+
+            for (std::size_t i = 0; i < kCategoryCount; ++i) values[i] = slots[i].value.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            for (std::size_t i = 0; i < kCategoryCount; ++i) {
+                if (slots[i].sequence.load(std::memory_order_relaxed) != before[i]) stable = false;
+            }
+            if (stable) return values;
+        }
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> sequence{0}; // Even = stable, odd = being written
+        std::atomic<std::uint64_t> value{0};    // Seconds credited
+    };
+    static_assert(sizeof(Slot) == 64, "one counter per cache line");
+
+    std::array<Slot, kCategoryCount> slots{};
+};
@@ -0,0 +1,229 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>   // For std::min
+#include <array>       // Category totals
+#include <cerrno>      // For EINTR
+#include <chrono>      // For the written-at stamp
+#include <cstddef>     // For offsetof
+#include <cstdint>     // Fixed-width on-disk fields
+#include <cstdio>      // For std::rename / std::remove
+#include <cstring>     // For std::memcpy
+#include <span>        // Session table to encode
+#include <string>      // For file paths
+#include <string_view> // Keys and names borrowed from the mapping
+#include <type_traits> // For the trivially-copyable checks
+#include <utility>     // For std::pair / std::move
+#include <vector>      // Reusable encode buffer, restored session table
+
+// 🐧 POSIX file I/O (write temp + fsync + rename)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "AppRegistry.hpp"    // Keys and names so ids can be re-interned
+#include "AppSession.hpp"     // AppSession records are stored verbatim
+#include "BaselineModel.hpp"  // Long-term usage baseline
+#include "BehaviorStats.hpp"  // Day aggregates
+#include "GitHubActivity.hpp" // Contribution counts
+#include "MappedFile.hpp"     // Zero-copy load
+#include "UsageCategory.hpp"  // Per-app category and totals
+
+// 💾 Lunr checkpoint: the analyzer's in-memory day, so a restart resumes instead of starting from zero
+//
+//    Layout (native endianness, one file, replaced atomically via rename):
+//      CheckpointHeader
+//      AppSession[sessionCount]                 verbatim (trivially copyable, 8-byte aligned)
+//      per session: CheckpointApp + key bytes + name bytes
+//
+//    Ids are per run, so a load re-interns every key and remaps the sessions (and the top app) onto the new ids.
+//    The header records sizeof(AppSession): a build with another layout ignores the file instead of misreading it.
+//    The usage baseline spans days, so it is restored even when the day's aggregates are stale.
+namespace checkpoint {
+
+constexpr char kMagic[8] = {'L', 'U', 'N', 'R', 'C', 'K', 'P', '1'};
+constexpr std::uint32_t kVersion = 3; // 2: GitHub contributions, 3: usage baseline
+
+struct CheckpointHeader {
+    char magic[8];                                       // kMagic
+    std::uint32_t version;                               // kVersion
+    std::uint32_t sessionSize;                           // sizeof(AppSession) of the writer
+    char date[16];                                       // "YYYY-MM-DD" the aggregates belong to
+    std::int64_t writtenEpoch;                           // When the checkpoint was taken
+    std::uint64_t sessionCount;                          // Entries in the session array
+    std::uint64_t nameBytes;                             // Size of the trailing name table
+    BehaviorStats stats;                                 // Day aggregates (topApp in writer ids)
+    ContributionCounts contributions;                    // GitHub activity counted today
+    std::array<std::uint64_t, kCategoryCount> categories; // Live category seconds
+    BaselineModel baseline;                              // Learned over weeks (not reset at midnight)
+};
+
+struct CheckpointApp {
+    std::uint32_t keyLength;
+    std::uint32_t nameLength;
+    UsageCategory category;
+    std::uint8_t reserved[7];
+};
+
+static_assert(std::is_trivially_copyable_v<BehaviorStats>, "BehaviorStats is stored verbatim");
+static_assert(std::is_trivially_copyable_v<CheckpointHeader>, "header is stored verbatim");
+static_assert(sizeof(CheckpointHeader) % alignof(AppSession) == 0, "session array must stay aligned");
+
+// 📦 What a load hands back, already remapped onto this run's ids
+struct Restored {
+    bool sameDay = false;             // False: only `baseline` was restored (the checkpoint is from another day)
+    BaselineModel baseline;
+    std::vector<AppSession> sessions; // Indexed by (new) AppId
+    BehaviorStats stats;
+    ContributionCounts contributions;
+    std::array<std::uint64_t, kCategoryCount> categories{};
+    std::vector<std::pair<AppId, UsageCategory>> appCategories; // For the classifier's per-id table
+};
+
+// ✍️ Encodes into a reusable buffer and replaces `path` atomically (temp file, fsync, rename)
+class Writer {
+public:
+    bool save(const std::string& path, std::string_view date, std::span<const AppSession> sessions,
+              const BehaviorStats& stats, const ContributionCounts& contributions,
+              const std::array<std::uint64_t, kCategoryCount>& categories, const BaselineModel& baseline,
+              const AppRegistry& registry) {
+        buffer.clear();
+
+        std::uint64_t count = 0;
+        for (const AppSession& session : sessions) count += session.focusHistogram.count() > 0 ? 1 : 0;
+
+        CheckpointHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.sessionSize = sizeof(AppSession);
+        std::memcpy(header.date, date.data(), std::min(date.size(), sizeof(header.date) - 1));
+        header.writtenEpoch = std::chrono::duration_cast<Seconds>(Clock::now().time_since_epoch()).count();
+        header.sessionCount = count;
+        header.stats = stats;
+        header.contributions = contributions;
+        header.categories = categories;
+        header.baseline = baseline;
+        put(&header, sizeof(header));
+
+        for (const AppSession& session : sessions) {
+            if (session.focusHistogram.count() > 0) put(&session, sizeof(session));
+        }
+
+        const std::size_t namesStart = buffer.size();
+        for (const AppSession& session : sessions) {
+            if (session.focusHistogram.count() == 0) continue;
+            const std::string& key = registry.keyOf(session.app);
+            const std::string& name = registry.nameOf(session.app);
+            CheckpointApp app{static_cast<std::uint32_t>(key.size()), static_cast<std::uint32_t>(name.size()),
+                              session.category, {}};
+            put(&app, sizeof(app));
+            put(key.data(), key.size());
+            put(name.data(), name.size());
+        }
+        const std::uint64_t nameBytes = buffer.size() - namesStart;
+        std::memcpy(buffer.data() + offsetof(CheckpointHeader, nameBytes), &nameBytes, sizeof(nameBytes));
+
+        return replace(path);
+    }
+
+private:
+    void put(const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    bool replace(const std::string& path) {
+        const std::string temp = path + ".tmp";
+        const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+
+        bool ok = true;
+        std::size_t written = 0;
+        while (written < buffer.size()) {
+            ssize_t n = ::write(fd, buffer.data() + written, buffer.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                ok = false;
+                break;
+            }
+            written += static_cast<std::size_t>(n);
+        }
+        ok = ok && ::fsync(fd) == 0; // The rename must never expose a file whose bytes are not on disk
+        ok = ::close(fd) == 0 && ok;
+
+        if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(temp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<unsigned char> buffer; // Capacity reused across checkpoints
+};
+
+// 📥 Maps `path` and restores it if it matches this build's layout: everything when it belongs to `date`,
+//    only the baseline otherwise (out.sameDay tells which). `intern(key, name)` returns the new id for each app.
+//    Returns false (leaving `out` untouched) for a missing or damaged checkpoint.
+template <typename Intern>
+bool load(const std::string& path, std::string_view date, Restored& out, Intern&& intern) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < sizeof(CheckpointHeader)) return false;
+
+    CheckpointHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.sessionSize != sizeof(AppSession)) {
+        return false;
+    }
+
+    const std::size_t sessionBytes = header.sessionCount * sizeof(AppSession);
+    if (header.sessionCount > AppRegistry::kMaxApps ||
+        file.size() != sizeof(CheckpointHeader) + sessionBytes + header.nameBytes) {
+        return false; // Torn or foreign file
+    }
+
+    const unsigned char* sessionsAt = file.data() + sizeof(CheckpointHeader);
+    const unsigned char* names = sessionsAt + sessionBytes;
+    const unsigned char* namesEnd = names + header.nameBytes;
+
+    Restored restored;
+    restored.baseline = header.baseline;
+    if (std::string_view(header.date, strnlen(header.date, sizeof(header.date))) != date) {
+        out = std::move(restored); // New day: keep learning, start the day's totals from zero
+        return true;
+    }
+
+    restored.sameDay = true;
+    restored.stats = header.stats;
+    restored.stats.topApp = AppRegistry::kUnknown;
+    restored.contributions = header.contributions;
+    restored.categories = header.categories;
+
+    for (std::uint64_t i = 0; i < header.sessionCount; ++i) {
+        CheckpointApp app;
+        if (namesEnd - names < static_cast<std::ptrdiff_t>(sizeof(app))) return false;
+        std::memcpy(&app, names, sizeof(app));
+        names += sizeof(app);
+        if (static_cast<std::size_t>(namesEnd - names) < std::size_t{app.keyLength} + app.nameLength) return false;
+        const std::string_view key(reinterpret_cast<const char*>(names), app.keyLength);
+        const std::string_view name(reinterpret_cast<const char*>(names) + app.keyLength, app.nameLength);
+        names += app.keyLength + app.nameLength;
+
+        AppSession session;
+        std::memcpy(&session, sessionsAt + i * sizeof(AppSession), sizeof(session));
+        const AppId oldId = session.app;
+        const AppId id = intern(key, name);
+        if (id == AppRegistry::kUnknown) continue; // Registry full
+
+        if (id >= restored.sessions.size()) restored.sessions.resize(id + 1);
+        session.app = id;
+        session.category = app.category;
+        restored.sessions[id] = session;
+        restored.appCategories.emplace_back(id, app.category);
+        if (oldId == header.stats.topApp) restored.stats.topApp = id;
+    }
+
+    out = std::move(restored);
+    return true;
+}
+
+} // namespace checkpoint
@@ -0,0 +1,55 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <atomic>          // Spill bytes read by the metrics thread
+#include <cstddef>         // For byte counts
+#include <memory>          // Owned initial block
+#include <memory_resource> // Monotonic arena and its upstream
+
+// 🧺 Per-day arena for the analyzer's session table
+//    - Everything the analyzer grows during a day (the AppSession table and its regrowths) carves from one
+//      monotonic buffer: allocation is a pointer bump, deallocation is free
+//    - At day rotation release() hands the whole day back in one shot and the next day reuses the same block
+//    - Only a day that outgrows the initial block reaches the heap; spilledBytes() says how much it took
+//    Analyzer thread only (std::pmr resources are not thread-safe); spilledBytes() may be read from anywhere
+class DayArena {
+public:
+    static constexpr std::size_t kDefaultBlockBytes = 512 * 1024; // ~600 apps' sessions, regrowths included
+
+    explicit DayArena(std::size_t blockBytes = kDefaultBlockBytes)
+        : block(std::make_unique<std::byte[]>(blockBytes)), blockSize(blockBytes),
+          day(block.get(), blockSize, &upstream) {}
+
+    DayArena(const DayArena&) = delete;
+    DayArena& operator=(const DayArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &day; }
+
+    // 🌅 Frees the day in one call; every container built on resource() must be destroyed or emptied first
+    void release() { day.release(); }
+
+    std::size_t blockBytes() const { return blockSize; }
+    std::size_t spilledBytes() const { return upstream.outstanding.load(std::memory_order_relaxed); }
+
+private:
+    // 📏 Heap upstream that keeps a running total, so a too-small block shows up in the metrics
+    struct CountingResource : std::pmr::memory_resource {
+        std::atomic<std::size_t> outstanding{0};
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            void* p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            outstanding.fetch_add(bytes, std::memory_order_relaxed);
+            return p;
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            outstanding.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    std::unique_ptr<std::byte[]> block;
+    std::size_t blockSize;
+    CountingResource upstream;               // Declared before `day`, which points at it
+    std::pmr::monotonic_buffer_resource day; // Rewinds to `block` on release()
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <array>        // Category totals
+#include <cstdint>      // For fixed-width totals
+#include <cstdio>       // For std::rename
+#include <cstdlib>      // For std::getenv
+#include <filesystem>   // For creating the export directory
+#include <span>         // Session table
+#include <string>       // For paths (built once per export, not per value)
+#include <string_view>  // Date and host are borrowed
+#include <system_error> // Non-throwing filesystem calls
+
+// 🐧 POSIX file I/O (temp file + atomic rename)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "AppRegistry.hpp"    // AppId → display name
+#include "AppSession.hpp"     // AppSession
+#include "BehaviorStats.hpp"  // Day-level aggregates
+#include "GitHubActivity.hpp" // Contribution counts
+#include "JsonWriter.hpp"     // Streaming serializer
+#include "UsageCategory.hpp"  // Category names
+
+// 📤 Daily JSON export for dashboards
+//
+//    {"date":"YYYY-MM-DD","host":"...",
+//     "apps":[{"app":"Safari","category":"Productivity","total_sec":N,"sessions":N,"p50_sec":N,"p90_sec":N},...],
+//     "categories":{"Other":N,"Productivity":N,...},
+//     "stats":{"focus_sec":N,"switches":N,"mean_focus_sec":X,"stddev_focus_sec":X,"fragmentation":X,"top_app":"..."},
+//     "github":{"commits":N,"pull_requests":N,"comments":N}}
+//
+//    Keys are short and output is compact: the day files are ingested from many machines.
+namespace day_export {
+
+// 📁 ~/Library/Application Support/Lunr/logs (falls back to ./logs without $HOME)
+inline std::filesystem::path defaultDirectory() {
+    const char* home = std::getenv("HOME");
+    if (!home || !*home) return "logs";
+    return std::filesystem::path(home) / "Library" / "Application Support" / "Lunr" / "logs";
+}
+
+// 🧾 Serializes one day (each app's category comes from its session)
+inline void writeDay(JsonWriter& json, std::string_view date, std::string_view host,
+                     std::span<const AppSession> sessions, const AppRegistry& registry,
+                     const std::array<std::uint64_t, kCategoryCount>& categoryTotals, const BehaviorStats& stats,
+                     const ContributionCounts& contributions) {
+    json.beginObject();
+    json.field("date", date);
+    json.field("host", host);
+
+    json.key("apps").beginArray();
+    for (const AppSession& session : sessions) {
+        if (session.focusHistogram.count() == 0) continue; // Interned but never credited
+        json.beginObject();
+        json.field("app", std::string_view(registry.nameOf(session.app)));
+        json.field("category", categoryName(session.category));
+        json.field("total_sec", session.totalDuration.count());
+        json.field("sessions", session.focusHistogram.count());
+        json.field("p50_sec", session.focusHistogram.percentile(0.5).count());
+        json.field("p90_sec", session.focusHistogram.percentile(0.9).count());
+        json.endObject();
+    }
+    json.endArray();
+
+    json.key("categories").beginObject();
+    for (std::size_t c = 0; c < kCategoryCount; ++c) {
+        json.field(categoryName(static_cast<UsageCategory>(c)), categoryTotals[c]);
+    }
+    json.endObject();
+
+    json.key("stats").beginObject();
+    json.field("focus_sec", stats.totalFocusTime.count());
+    json.field("switches", stats.totalSwitches);
+    json.field("mean_focus_sec", stats.meanFocus);
+    json.field("stddev_focus_sec", stats.focusStdDev());
+    json.field("fragmentation", stats.fragmentationIndex());
+    json.field("top_app", std::string_view(registry.nameOf(stats.topApp)));
+    json.endObject();
+
+    json.key("github").beginObject();
+    json.field("commits", contributions.commits);
+    json.field("pull_requests", contributions.pullRequests);
+    json.field("comments", contributions.comments);
+    json.endObject();
+
+    json.endObject();
+}
+
+// 💾 Writes <directory>/<date>.json via a temp file + rename, so ingesters never see a partial day
+//    Returns the final path, or an empty path on failure
+inline std::filesystem::path exportDay(const std::filesystem::path& directory, std::string_view date,
+                                       std::string_view host, std::span<const AppSession> sessions,
+                                       const AppRegistry& registry,
+                                       const std::array<std::uint64_t, kCategoryCount>& categoryTotals,
+                                       const BehaviorStats& stats, const ContributionCounts& contributions) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) return {};
+
+    const std::filesystem::path target = directory / (std::string(date) + ".json");
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return {};
+
+    bool written;
+    {
+        JsonWriter json(fd);
+        writeDay(json, date, host, sessions, registry, categoryTotals, stats, contributions);
+        written = json.flush() && json.good();
+    }
+    written = ::close(fd) == 0 && written;
+
+    if (!written || std::rename(temp.c_str(), target.c_str()) != 0) {
+        std::filesystem::remove(temp, error);
+        return {};
+    }
+    return target;
+}
+
+} // namespace day_export
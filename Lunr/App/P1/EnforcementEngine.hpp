@@ -0,0 +1,330 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>     // For std::sort / std::min
+#include <array>         // Per-category ranges and daily totals
+#include <cstdint>       // Compact rule fields
+#include <fstream>       // Rules file
+#include <sstream>       // Tokenizing rule lines (load time only)
+#include <string>        // Rule targets
+#include <string_view>   // Parsing helpers
+#include <unordered_map> // App key → rule range (bind time only)
+#include <vector>        // Flat rule table and per-app index
+
+#include "AppRegistry.hpp"   // AppId
+#include "ReportWriter.hpp"  // Rule descriptions for alerts
+#include "UsageCategory.hpp" // Category keys
+
+// 🔒 Phase 2 enforcement: rules compiled once into a flat table and evaluated on every switch
+//
+//    lunr_rules.txt, one rule per line ("target = action condition"; target is a category, bundle id, display
+//    name or site):
+//      Entertainment    = block after 2h                      daily budget
+//      com.hbo.hbomax   = block during 09:00-17:00 weekdays   blocked window (weekdays | weekends | daily)
+//      Games            = block until 1 contributions         GitHub goal gate ("meet your Git goal first")
+//      Social           = warn after 30m                      warning instead of a block
+//
+//    - Compiled rules are 16 bytes, sorted so each app id and each category owns one contiguous range
+//    - App-keyed rules are bound to an AppId once, when the id is interned; the switch path is two index
+//      lookups plus a scan of the (few) rules in those ranges, with no strings, hashing or allocation
+//    - Budgets are checked against daily totals the engine keeps itself (credited at every switch), so the
+//      decision needs nothing from other threads
+enum class RuleAction : std::uint8_t { Allow, Warn, Block };
+
+struct EnforcementDecision {
+    RuleAction action = RuleAction::Allow;
+    int rule = -1;                    // Index into the rule table (for the message), -1 when allowed
+    std::uint32_t allowanceSec = 0;   // Seconds until the earliest rule could trigger for this app (0 = none)
+};
+
+// 📥 Live values a decision reads that the engine does not track itself
+struct EnforcementContext {
+    int dayKey;                       // Local day number (budgets reset when it changes)
+    int weekday;                      // 0 = Sunday
+    int minuteOfDay;                  // Local minutes since midnight
+    std::uint32_t secondOfMinute;     // For exact allowances
+    std::uint32_t contributions;      // GitHub contributions counted today
+    std::uint32_t openSeconds = 0;    // Time already spent in the still-open session (deadline re-checks)
+};
+
+class EnforcementEngine {
+public:
+    static constexpr std::uint8_t kWeekdays = 0b0111110;
+    static constexpr std::uint8_t kWeekends = 0b1000001;
+    static constexpr std::uint8_t kEveryDay = 0b1111111;
+
+    // 📂 Parses rules (blank lines and '#' comments skipped) and compiles the table; returns the rules loaded
+    std::size_t loadRules(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            const auto equals = line.rfind('=');
+            if (equals == std::string::npos) continue;
+            addRule(trim(std::string_view(line).substr(0, equals)), std::string_view(line).substr(equals + 1));
+        }
+        compile();
+        return rules.size();
+    }
+
+    // ➕ One rule, e.g. addRule("Games", "block until 1 contributions"); call compile() afterwards
+    bool addRule(std::string_view target, std::string_view spec) {
+        Rule rule{};
+        if (!parseSpec(spec, rule)) return false;
+        UsageCategory category;
+        if (parseCategory(target, category)) {
+            rule.byCategory = true;
+            rule.scopeKey = static_cast<std::uint16_t>(category);
+        }
+        pendingRules.push_back({std::string(target), rule});
+        return true;
+    }
+
+    // 🧱 Builds the flat table: category rules first (grouped by category), then app rules (grouped by key).
+    //    Run before the first bindApp(): bindings made earlier are not kept
+    void compile() {
+        std::stable_sort(pendingRules.begin(), pendingRules.end(), [](const Pending& a, const Pending& b) {
+            if (a.rule.byCategory != b.rule.byCategory) return a.rule.byCategory;
+            if (a.rule.byCategory) return a.rule.scopeKey < b.rule.scopeKey;
+            return a.target < b.target;
+        });
+
+        rules.clear();
+        targets.clear();
+        byApp.clear();
+        byCategory.fill({});
+        byKey.clear();
+        for (const Pending& pending : pendingRules) {
+            const auto index = static_cast<std::uint16_t>(rules.size());
+            rules.push_back(pending.rule);
+            targets.push_back(pending.target);
+            Range& range = pending.rule.byCategory ? byCategory[pending.rule.scopeKey] : byKey[pending.target];
+            if (range.count == 0) range.first = index;
+            ++range.count;
+        }
+        warnedDay.assign(rules.size(), -1);
+    }
+
+    // 🔗 Attaches app-keyed rules to a freshly interned id (observer thread, once per id per key)
+    void bindApp(AppId id, std::string_view key, std::string_view displayName) {
+        if (id >= byApp.size()) {
+            byApp.resize(id + 1);
+            appSeconds.resize(id + 1, 0);
+        }
+        if (byKey.empty()) return;
+        for (std::string_view candidate : {key, displayName}) {
+            auto found = byKey.find(std::string(candidate));
+            if (found != byKey.end()) {
+                byApp[id] = found->second;
+                return;
+            }
+        }
+    }
+
+    // ⏱️ Adds a closed session to today's totals (observer thread)
+    void credit(AppId app, UsageCategory category, std::uint32_t seconds, int dayKey) {
+        rollDay(dayKey);
+        if (app < appSeconds.size()) appSeconds[app] += seconds;
+        categorySeconds[static_cast<std::size_t>(category)] += seconds;
+    }
+
+    // ⚖️ Decision for focus moving to `app` (observer thread; the hot path)
+    EnforcementDecision evaluate(AppId app, UsageCategory category, const EnforcementContext& context) {
+        rollDay(context.dayKey);
+        EnforcementDecision decision;
+        std::uint32_t allowance = kNoAllowance;
+
+        auto scan = [&](Range range, std::uint32_t used) {
+            for (std::uint16_t i = range.first; i < range.first + range.count; ++i) {
+                const Rule& rule = rules[i];
+                const std::uint32_t left = remaining(rule, used, context);
+                if (left == 0) {
+                    if (rule.action > decision.action) {
+                        decision.action = rule.action;
+                        decision.rule = i;
+                    }
+                } else {
+                    allowance = std::min(allowance, left);
+                }
+            }
+        };
+        if (app < byApp.size()) scan(byApp[app], appSeconds[app] + context.openSeconds);
+        scan(byCategory[static_cast<std::size_t>(category)],
+             categorySeconds[static_cast<std::size_t>(category)] + context.openSeconds);
+
+        decision.allowanceSec = allowance == kNoAllowance ? 0 : allowance;
+        if (decision.action == RuleAction::Warn) { // Warnings fire once per rule per day; blocks every time
+            if (warnedDay[decision.rule] == context.dayKey) return {RuleAction::Allow, -1, decision.allowanceSec};
+            warnedDay[decision.rule] = context.dayKey;
+        }
+        return decision;
+    }
+
+    // 🏷️ Writes a human-readable rule for messages ("Entertainment: block after 120m today"); no allocation,
+    //    so alerts can be formatted on the observer thread
+    void describe(int rule, ReportWriter& out) const {
+        if (rule < 0 || static_cast<std::size_t>(rule) >= rules.size()) return;
+        const Rule& r = rules[rule];
+        static constexpr const char* kinds[] = {"after", "during", "until"};
+        out << targets[rule] << ": " << (r.action == RuleAction::Block ? "block " : "warn ")
+            << kinds[static_cast<int>(r.kind)] << ' ';
+        switch (r.kind) {
+        case RuleKind::Budget: out << r.a / 60 << "m today"; break;
+        case RuleKind::Window:
+            out << r.a / 60 << ':' << (r.a % 60 < 10 ? "0" : "") << r.a % 60 << '-' << r.b / 60 << ':'
+                << (r.b % 60 < 10 ? "0" : "") << r.b % 60;
+            break;
+        case RuleKind::Gate: out << r.a << " contributions"; break;
+        }
+    }
+
+    std::size_t size() const { return rules.size(); }
+
+private:
+    enum class RuleKind : std::uint8_t { Budget, Window, Gate };
+
+    struct Rule {
+        RuleKind kind;
+        RuleAction action;
+        std::uint8_t weekdays;   // Window: bit d set = active on weekday d
+        bool byCategory;         // Scope: category (scopeKey) or app (bound through byApp)
+        std::uint16_t scopeKey;  // Category index
+        std::uint16_t reserved;
+        std::uint32_t a;         // Budget: limit (s) | Window: start minute | Gate: contributions needed
+        std::uint32_t b;         // Window: end minute (exclusive, 1440 = midnight; may wrap past midnight)
+    };
+    static_assert(sizeof(Rule) == 16, "compiled rules should stay 16 bytes");
+
+    struct Range {
+        std::uint16_t first = 0;
+        std::uint16_t count = 0;
+    };
+
+    struct Pending {
+        std::string target;
+        Rule rule;
+    };
+
+    static constexpr std::uint32_t kNoAllowance = ~0u;
+
+    // ⏳ Seconds before `rule` triggers (0 = triggering now)
+    static std::uint32_t remaining(const Rule& rule, std::uint32_t used, const EnforcementContext& context) {
+        switch (rule.kind) {
+        case RuleKind::Budget: return used >= rule.a ? 0 : rule.a - used;
+        case RuleKind::Gate: return context.contributions >= rule.a ? kNoAllowance : 0;
+        case RuleKind::Window: {
+            if (!(rule.weekdays & (1u << context.weekday))) return kNoAllowance; // Not today (re-checked at switch)
+            const auto now = static_cast<std::uint32_t>(context.minuteOfDay);
+            const bool inside = rule.a <= rule.b ? (now >= rule.a && now < rule.b) : (now >= rule.a || now < rule.b);
+            if (inside) return 0;
+            const std::uint32_t minutes = (rule.a + 1440 - now) % 1440;
+            return minutes * 60 - context.secondOfMinute;
+        }
+        }
+        return kNoAllowance;
+    }
+
+    void rollDay(int dayKey) {
+        if (dayKey == currentDay) return;
+        currentDay = dayKey;
+        std::fill(appSeconds.begin(), appSeconds.end(), 0);
+        categorySeconds.fill(0);
+    }
+
+    // 🧾 "block after 2h" | "warn during 09:00-17:00 weekdays" | "block until 3 contributions"
+    static bool parseSpec(std::string_view spec, Rule& rule) {
+        std::istringstream words{std::string(spec)};
+        std::string action, kind, value, extra;
+        words >> action >> kind >> value >> extra;
+
+        if (action == "block") rule.action = RuleAction::Block;
+        else if (action == "warn") rule.action = RuleAction::Warn;
+        else return false;
+
+        if (kind == "after") {
+            rule.kind = RuleKind::Budget;
+            return parseDuration(value, rule.a);
+        }
+        if (kind == "until") {
+            rule.kind = RuleKind::Gate;
+            return parseNumber(value, rule.a) && (extra.empty() || extra.rfind("contribution", 0) == 0);
+        }
+        if (kind == "during") {
+            rule.kind = RuleKind::Window;
+            const auto dash = value.find('-');
+            if (dash == std::string::npos || !parseClock(std::string_view(value).substr(0, dash), rule.a, false) ||
+                !parseClock(std::string_view(value).substr(dash + 1), rule.b, true)) {
+                return false;
+            }
+            if (extra.empty() || extra == "daily") rule.weekdays = kEveryDay;
+            else if (extra == "weekdays") rule.weekdays = kWeekdays;
+            else if (extra == "weekends") rule.weekdays = kWeekends;
+            else return false;
+            return true;
+        }
+        return false;
+    }
+
+    // "2h", "30m", "90s", "1h30m" → seconds
+    static bool parseDuration(std::string_view text, std::uint32_t& seconds) {
+        seconds = 0;
+        std::uint32_t number = 0;
+        bool digits = false;
+        for (char c : text) {
+            if (c >= '0' && c <= '9') {
+                number = number * 10 + static_cast<std::uint32_t>(c - '0');
+                digits = true;
+                continue;
+            }
+            if (!digits) return false;
+            if (c == 'h') seconds += number * 3600;
+            else if (c == 'm') seconds += number * 60;
+            else if (c == 's') seconds += number;
+            else return false;
+            number = 0;
+            digits = false;
+        }
+        return !digits && seconds > 0;
+    }
+
+    // "HH:MM" → minute of day; an end bound may also be "24:00" (1440, so "00:00-24:00" is the whole day)
+    static bool parseClock(std::string_view text, std::uint32_t& minute, bool endBound) {
+        const auto colon = text.find(':');
+        std::uint32_t hours = 0, minutes = 0;
+        if (colon == std::string_view::npos || !parseNumber(text.substr(0, colon), hours) ||
+            !parseNumber(text.substr(colon + 1), minutes) || minutes > 59) {
+            return false;
+        }
+        if (hours > 23 && !(endBound && hours == 24 && minutes == 0)) return false;
+        minute = hours * 60 + minutes;
+        return true;
+    }
+
+    static bool parseNumber(std::string_view text, std::uint32_t& value) {
+        if (text.empty()) return false;
+        value = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') return false;
+            value = value * 10 + static_cast<std::uint32_t>(c - '0');
+        }
+        return true;
+    }
+
+    static std::string trim(std::string_view text) {
+        const auto first = text.find_first_not_of(" \t");
+        if (first == std::string_view::npos) return {};
+        const auto last = text.find_last_not_of(" \t\r");
+        return std::string(text.substr(first, last - first + 1));
+    }
+
+    std::vector<Pending> pendingRules;                  // Source rules (load time)
+    std::vector<Rule> rules;                            // Flat compiled table
+    std::vector<std::string> targets;                   // Rule index → target (messages only)
+    std::array<Range, kCategoryCount> byCategory{};     // Category → rule range
+    std::unordered_map<std::string, Range> byKey;       // App key → rule range (bind time only)
+    std::vector<Range> byApp;                           // AppId → rule range (hot path)
+    std::vector<std::uint32_t> appSeconds;              // Today's seconds per app
+    std::array<std::uint32_t, kCategoryCount> categorySeconds{}; // Today's seconds per category
+    std::vector<int> warnedDay;                         // Rule → day its warning last fired
+    int currentDay = -1;
+};
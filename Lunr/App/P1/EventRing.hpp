@@ -0,0 +1,58 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <array>   // Fixed slot storage (no allocation after construction)
+#include <atomic>  // Lock-free head/tail indices
+#include <cstddef> // For std::size_t
+
+// 🔁 Bounded lock-free single-producer/single-consumer ring
+//    - Exactly one thread may call tryPush (the observer), exactly one may call tryPop/drain (the analyzer)
+//    - Neither side ever blocks: a full ring rejects the push and counts it as dropped
+template <typename T, std::size_t Capacity>
+class EventRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // ➕ Producer side: returns false (and counts a drop) if the consumer has fallen a full ring behind
+    bool tryPush(const T& item) noexcept {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release); // Publish the slot to the consumer
+        return true;
+    }
+
+    // ➖ Consumer side: returns false when the ring is empty
+    bool tryPop(T& out) noexcept {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        out = slots[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release); // Hand the slot back to the producer
+        return true;
+    }
+
+    // 🚰 Consumer side: pops everything currently published and passes each item to fn
+    template <typename Fn>
+    std::size_t drain(Fn&& fn) {
+        std::size_t count = 0;
+        T item;
+        while (tryPop(item)) {
+            fn(item);
+            ++count;
+        }
+        return count;
+    }
+
+    // 📉 Number of pushes rejected because the ring was full (readable from either side)
+    std::size_t dropped() const noexcept { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    // Indices grow monotonically and are masked on access; each lives on its own cache line
+    alignas(64) std::atomic<std::size_t> head{0};         // Next slot to read (written by consumer)
+    alignas(64) std::atomic<std::size_t> tail{0};         // Next slot to write (written by producer)
+    alignas(64) std::atomic<std::size_t> droppedCount{0}; // Rejected pushes (written by producer)
+    std::array<T, Capacity> slots{};
+};
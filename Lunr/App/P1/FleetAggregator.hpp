@@ -0,0 +1,244 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>          // For std::max / std::sort
+#include <array>              // Category totals
+#include <atomic>             // Merge counters read by the reporter
+#include <condition_variable> // Worker wake-up
+#include <cstdint>            // For counters and epochs
+#include <deque>              // Per-shard job queue
+#include <functional>         // For std::hash
+#include <memory>             // Shards are pinned (they own a mutex and a thread)
+#include <mutex>              // Queue and rollup locks
+#include <stop_token>         // For the draining shutdown
+#include <string>             // User and team names
+#include <string_view>        // Names borrowed from a payload
+#include <thread>             // For std::jthread
+#include <unordered_map>      // Name → rollup
+#include <utility>            // For std::move / std::pair
+#include <vector>             // Payloads and report rows
+
+#include "AppSession.hpp"         // Seconds
+#include "CategoryClassifier.hpp" // App name → category (built-ins + the service's rules)
+#include "FleetProtocol.hpp"      // Batch decoding, Identity
+#include "HistoryReader.hpp"      // HistoryAggregate: per-app sessions + BehaviorStats keyed by app name
+#include "ReportWriter.hpp"       // Rollup report formatting
+#include "UsageCategory.hpp"      // kCategoryCount, category names
+
+// 📊 One user's or one team's rollup: the analyzer's own aggregate types (AppSession, BehaviorStats) by app
+//    name, plus per-category seconds
+struct FleetRollup {
+    HistoryAggregate usage;                                 // Per-app sessions and behavior stats
+    std::vector<UsageCategory> categoryOf;                  // Parallel to usage.names
+    std::array<std::uint64_t, kCategoryCount> categories{}; // Focus seconds per category
+    std::uint64_t batches = 0;                              // Batches merged into this rollup
+    std::uint32_t members = 0;                              // Teams: users merged in
+    std::int64_t lastSessionEpoch = 0;                      // Newest session start seen
+
+    // 🆔 Rollup-local id for `name`, created (with its category) on first sight
+    AppId idFor(std::string_view name, UsageCategory category) {
+        const AppId id = usage.idFor(name);
+        if (id >= categoryOf.size()) categoryOf.resize(id + 1, category);
+        return id;
+    }
+
+    void record(AppId id, Seconds duration, std::int64_t startEpoch) {
+        usage.record(id, duration);
+        categories[static_cast<std::size_t>(categoryOf[id])] += static_cast<std::uint64_t>(duration.count());
+        lastSessionEpoch = std::max(lastSessionEpoch, startEpoch);
+    }
+
+    // 🔗 Reduction step for team partials held by different shards
+    void merge(const FleetRollup& other) {
+        for (AppId id = 0; id < other.usage.names.size(); ++id) idFor(other.usage.names[id], other.categoryOf[id]);
+        usage.merge(other.usage);
+        for (std::size_t c = 0; c < kCategoryCount; ++c) categories[c] += other.categories[c];
+        batches += other.batches;
+        members += other.members;
+        lastSessionEpoch = std::max(lastSessionEpoch, other.lastSessionEpoch);
+    }
+};
+
+// 🏭 Fleet merge pool: decodes Batch payloads and folds them into per-user and per-team rollups
+//    - One shard per worker thread; a user always hashes to the same shard, so each user's batches merge in
+//      arrival order and every rollup has exactly one writer (the shard's lock only serialises readers)
+//    - Teams span shards: each shard keeps a partial per team, merged when a report asks for teams()
+//    - submit() never waits on merging; a full shard queue refuses the batch, and the connection that sent
+//      it is dropped so its agent backs off and re-sends later (nothing is acked that was not queued)
+class FleetAggregator {
+public:
+    static constexpr std::size_t kMaxQueued = 1024; // Batches waiting per shard
+
+    explicit FleetAggregator(const CategoryClassifier& rules, unsigned workers = 0) : classifier(rules) {
+        if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+        shards.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w) shards.push_back(std::make_unique<Shard>());
+    }
+
+    FleetAggregator(const FleetAggregator&) = delete;
+    FleetAggregator& operator=(const FleetAggregator&) = delete;
+    ~FleetAggregator() { stop(); }
+
+    void start() {
+        for (auto& shard : shards) {
+            shard->worker = std::jthread([this, s = shard.get()](std::stop_token stop) { work(*s, stop); });
+        }
+    }
+
+    // 🛑 Merges everything already queued, then joins the workers
+    void stop() {
+        for (auto& shard : shards) shard->worker.request_stop();
+        for (auto& shard : shards) {
+            if (shard->worker.joinable()) shard->worker.join();
+        }
+    }
+
+    // ➕ Queues one Batch payload from `identity` (any thread); false if its shard is saturated
+    bool submit(const fleet::Identity& identity, std::vector<unsigned char> payload) {
+        Shard& shard = *shards[std::hash<std::string>{}(identity.user) % shards.size()];
+        {
+            std::lock_guard<std::mutex> lock(shard.queueMutex);
+            if (shard.queue.size() >= kMaxQueued) return false;
+            shard.queue.push_back(Job{identity.user, identity.team, std::move(payload)});
+        }
+        shard.ready.notify_one();
+        return true;
+    }
+
+    unsigned workerCount() const { return static_cast<unsigned>(shards.size()); }
+    std::uint64_t merged() const { return mergedBatches.load(std::memory_order_relaxed); }
+    std::uint64_t malformed() const { return malformedBatches.load(std::memory_order_relaxed); }
+    std::uint64_t sessions() const { return mergedSessions.load(std::memory_order_relaxed); }
+
+    // 📋 Copies of every user's rollup, by name (each shard is locked only while it is copied)
+    std::vector<std::pair<std::string, FleetRollup>> users() const {
+        std::vector<std::pair<std::string, FleetRollup>> rows;
+        for (const auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->rollupMutex);
+            for (const auto& [name, rollup] : shard->users) rows.emplace_back(name, rollup);
+        }
+        std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        return rows;
+    }
+
+    // 👥 Every team's rollup, with the shards' partials merged, by name
+    std::vector<std::pair<std::string, FleetRollup>> teams() const {
+        std::unordered_map<std::string, FleetRollup> merged;
+        for (const auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->rollupMutex);
+            for (const auto& [name, rollup] : shard->teams) merged[name].merge(rollup);
+        }
+        std::vector<std::pair<std::string, FleetRollup>> rows(merged.begin(), merged.end());
+        std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        return rows;
+    }
+
+private:
+    struct Job {
+        std::string user;
+        std::string team;
+        std::vector<unsigned char> payload;
+    };
+
+    // 🔗 Where one batch-local app id lands in the user's and the team's rollups
+    struct Binding {
+        AppId user = 0;
+        AppId team = 0;
+        bool named = false;
+    };
+
+    struct Shard {
+        std::mutex queueMutex;
+        std::condition_variable_any ready;
+        std::deque<Job> queue;
+
+        mutable std::mutex rollupMutex; // Held by the worker per batch and by report copies
+        std::unordered_map<std::string, FleetRollup> users;
+        std::unordered_map<std::string, FleetRollup> teams; // Partials: only this shard's users
+        std::vector<Binding> bindings;                      // Worker only
+
+        std::jthread worker; // Declared last: joined before the state it uses is destroyed
+    };
+
+    // 🧵 Shard worker: pops batches until stop is requested and the queue is empty
+    void work(Shard& shard, std::stop_token stop) {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(shard.queueMutex);
+                shard.ready.wait(lock, stop, [&] { return !shard.queue.empty(); });
+                if (shard.queue.empty()) return; // Stopped with nothing left to merge
+                job = std::move(shard.queue.front());
+                shard.queue.pop_front();
+            }
+            merge(shard, job);
+        }
+    }
+
+    // 🔗 Decodes one batch straight into the user's rollup and the user's team partial
+    void merge(Shard& shard, const Job& job) {
+        std::vector<Binding>& bindings = shard.bindings; // Batch-local id → rollup ids (capacity reused)
+        bindings.clear();
+        std::uint64_t sessionCount = 0;
+
+        std::lock_guard<std::mutex> lock(shard.rollupMutex);
+        auto [userIt, newUser] = shard.users.try_emplace(job.user);
+        FleetRollup& user = userIt->second;
+        FleetRollup& team = shard.teams[job.team.empty() ? std::string("(no team)") : job.team];
+        if (newUser) ++team.members;
+
+        fleet::BatchInfo info;
+        const bool valid = fleet::decodeBatch(
+            job.payload.data(), job.payload.size(), info,
+            [&](AppId id, std::string_view name) { // Hash and classify each name once per batch, not per session
+                if (id >= bindings.size()) bindings.resize(id + 1);
+                const UsageCategory category = classifier.classify(name, name);
+                bindings[id] = Binding{user.idFor(name, category), team.idFor(name, category), true};
+            },
+            [&](const journal::JournalRecord& record) {
+                if (record.app >= bindings.size() || !bindings[record.app].named) return;
+                const Binding& binding = bindings[record.app];
+                const Seconds duration(record.durationSec);
+                user.record(binding.user, duration, record.startEpoch);
+                team.record(binding.team, duration, record.startEpoch);
+                ++sessionCount;
+            });
+        ++user.batches;
+        ++team.batches;
+
+        mergedBatches.fetch_add(1, std::memory_order_relaxed);
+        mergedSessions.fetch_add(sessionCount, std::memory_order_relaxed);
+        if (!valid) malformedBatches.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const CategoryClassifier& classifier; // Read-only once the pool starts (classify() is const)
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<std::uint64_t> mergedBatches{0};
+    std::atomic<std::uint64_t> mergedSessions{0};
+    std::atomic<std::uint64_t> malformedBatches{0};
+};
+
+// 🖨️ Formats rollups ("team" / "user" headings) in the agent's snapshot style
+inline void writeFleetRollups(std::string_view kind, const std::vector<std::pair<std::string, FleetRollup>>& rows,
+                              ReportWriter& out) {
+    for (const auto& [name, rollup] : rows) {
+        const BehaviorStats& stats = rollup.usage.stats;
+        out << "\n🛰️ [Fleet] " << kind << " " << name;
+        if (rollup.members > 0) out << " (" << rollup.members << " users)";
+        out << ":\n";
+        out << " - Focus Time: " << MinSec{stats.totalFocusTime.count()} << " over " << stats.totalSwitches
+            << " sessions\n";
+        if (stats.totalSwitches > 0) {
+            out << " - Top App: " << rollup.usage.names[stats.topApp] << " (" << MinSec{stats.topDuration.count()}
+                << ")\n";
+        }
+        out << " - Avg. Focus Time: " << Fixed{stats.meanFocus} << "s\n";
+        out << " - Focus Std. Dev.: " << Fixed{stats.focusStdDev()} << "s\n";
+        for (std::size_t c = 0; c < kCategoryCount; ++c) {
+            if (rollup.categories[c] == 0) continue;
+            out << " - " << categoryName(static_cast<UsageCategory>(c)) << ": "
+                << MinSec{static_cast<long long>(rollup.categories[c])} << "\n";
+        }
+    }
+    out.flush();
+}
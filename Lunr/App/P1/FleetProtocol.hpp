@@ -0,0 +1,333 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <cerrno>      // For EINTR
+#include <cstdint>     // Fixed-width wire fields
+#include <cstring>     // For std::memcpy
+#include <string>      // Host names, decoded identity
+#include <string_view> // Names and dates borrowed from the payload
+#include <vector>      // Reusable encode buffers
+
+// 🐧 POSIX sockets
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "AppRegistry.hpp"    // AppId
+#include "SessionJournal.hpp" // JournalRecord, the data every batch carries
+
+// 🛰️ Lunr fleet wire protocol: agents stream their session journals to an aggregation service (LunrFleet)
+//
+//    One persistent TCP connection per agent, carrying frames of a 24-byte FrameHeader plus payload:
+//      Hello  agent → service, once per connection: agent id, user, team (varint-length strings)
+//      Batch  agent → service: a slice [fromOffset, toOffset) of one day's journal file, compacted
+//      Ack    service → agent: echoes a Batch's sequence once it is queued for merging, with the service's
+//             high-water offset for that agent and day (varint; the Batch's toOffset unless it overlapped)
+//
+//    A Batch is the journal's own content with the fixed 16-byte slots squeezed out (typically 3-5 bytes per
+//    session instead of 16, no compression library needed):
+//      varint date length, date bytes, varint fromOffset, varint toOffset, then items:
+//        varint 0, varint app, varint length, name bytes        name entry (precedes its id's first record)
+//        varint app + 1, zigzag varint (start - previous end), varint duration          one session
+//    Ids are the journal file's own; every batch re-announces the names it uses, so it decodes on its own.
+//    The offsets let the service drop a slice it already merged (an Ack lost on a broken connection)
+namespace fleet {
+
+constexpr char kMagic[4] = {'L', 'N', 'R', 'F'};
+constexpr std::uint16_t kVersion = 1;
+constexpr std::uint16_t kDefaultPort = 7419;
+constexpr std::uint32_t kMaxPayload = 8u << 20; // A busy day compacts to ~100 KiB; anything this big is garbage
+
+enum class FrameKind : std::uint16_t { Hello = 1, Batch = 2, Ack = 3 };
+
+struct FrameHeader {
+    char magic[4];              // kMagic
+    std::uint16_t version;      // kVersion
+    std::uint16_t kind;         // FrameKind
+    std::uint32_t payloadBytes; // Bytes following the header
+    std::uint32_t records;      // Batch: sessions it carries (0 otherwise)
+    std::uint64_t sequence;     // Batch: sender's sequence; Ack: the sequence acknowledged
+};
+
+static_assert(sizeof(FrameHeader) == 24, "frame header is sent verbatim");
+
+// ✅ Parses a header from `data` (at least sizeof(FrameHeader) bytes); false if it is not a frame we accept
+inline bool readHeader(const unsigned char* data, FrameHeader& header) {
+    std::memcpy(&header, data, sizeof(header));
+    return std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 && header.version == kVersion &&
+           header.payloadBytes <= kMaxPayload;
+}
+
+// 📦 Appends a whole frame (header + payload) to `out`
+inline void appendFrame(std::vector<unsigned char>& out, FrameKind kind, std::uint64_t sequence,
+                        std::uint32_t records, const std::vector<unsigned char>& payload) {
+    FrameHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.kind = static_cast<std::uint16_t>(kind);
+    header.payloadBytes = static_cast<std::uint32_t>(payload.size());
+    header.records = records;
+    header.sequence = sequence;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&header);
+    out.insert(out.end(), bytes, bytes + sizeof(header));
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+// 🔢 LEB128 varints (and zigzag for the rare negative gap: clock changes, overlapping agent runs)
+inline void putVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+inline void putString(std::vector<unsigned char>& out, std::string_view text) {
+    putVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+inline std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// 📖 Bounds-checked cursor over a received payload; any overrun latches `ok` to false
+struct PayloadReader {
+    const unsigned char* at;
+    const unsigned char* end;
+    bool ok = true;
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (at == end) break;
+            const unsigned char byte = *at++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+    std::string_view string() {
+        const std::uint64_t length = varint();
+        if (!ok || length > static_cast<std::uint64_t>(end - at)) {
+            ok = false;
+            return {};
+        }
+        std::string_view text(reinterpret_cast<const char*>(at), static_cast<std::size_t>(length));
+        at += length;
+        return text;
+    }
+
+    bool done() const { return at == end; }
+};
+
+// 👋 Who is on the other end of a connection
+struct Identity {
+    std::string agent; // Machine (host name by default); batches are de-duplicated per agent and day
+    std::string user;
+    std::string team;
+};
+
+inline void encodeHello(const Identity& identity, std::vector<unsigned char>& out) {
+    out.clear();
+    putString(out, identity.agent);
+    putString(out, identity.user);
+    putString(out, identity.team);
+}
+
+inline bool decodeHello(const unsigned char* data, std::size_t size, Identity& identity) {
+    PayloadReader in{data, data + size};
+    identity.agent = in.string();
+    identity.user = in.string();
+    identity.team = in.string();
+    return in.ok && in.done() && !identity.agent.empty();
+}
+
+inline void encodeAck(std::uint64_t highWater, std::vector<unsigned char>& out) {
+    out.clear();
+    putVarint(out, highWater);
+}
+
+inline bool decodeAck(const unsigned char* data, std::size_t size, std::uint64_t& highWater) {
+    PayloadReader in{data, data + size};
+    highWater = in.varint();
+    return in.ok && in.done();
+}
+
+// ✍️ Builds one Batch payload from journal entries, in journal order (buffer capacities are reused):
+//    begin(), name() / record() while walking, then finish() once the slice's end offset is known
+class BatchEncoder {
+public:
+    void begin() {
+        items.clear();
+        count = 0;
+        previousEnd = 0;
+    }
+
+    void name(AppId app, std::string_view text) {
+        putVarint(items, 0);
+        putVarint(items, app);
+        putString(items, text);
+    }
+
+    void record(const journal::JournalRecord& record) {
+        putVarint(items, static_cast<std::uint64_t>(record.app) + 1);
+        putVarint(items, zigzag(record.startEpoch - previousEnd)); // Back-to-back sessions encode as 0
+        putVarint(items, record.durationSec);
+        previousEnd = record.startEpoch + record.durationSec;
+        ++count;
+    }
+
+    const std::vector<unsigned char>& finish(std::string_view date, std::uint64_t fromOffset,
+                                             std::uint64_t toOffset) {
+        out.clear();
+        putString(out, date);
+        putVarint(out, fromOffset);
+        putVarint(out, toOffset);
+        out.insert(out.end(), items.begin(), items.end());
+        return out;
+    }
+
+    std::uint32_t records() const { return count; }
+
+private:
+    std::vector<unsigned char> items;
+    std::vector<unsigned char> out;
+    std::uint32_t count = 0;
+    std::int64_t previousEnd = 0;
+};
+
+// 🧾 Fixed part of a decoded Batch
+struct BatchInfo {
+    std::string_view date; // Views the payload
+    std::uint64_t fromOffset = 0;
+    std::uint64_t toOffset = 0;
+};
+
+// 🚶 Decodes a Batch payload in place:
+//      onName(AppId, std::string_view)           for each name entry (view points into `data`)
+//      onRecord(const journal::JournalRecord&)   for each session
+//    Returns false for a malformed payload (callbacks may already have run for its valid prefix).
+//    readBatchInfo() parses only the fixed part, for routing and de-duplication before the full decode
+inline bool readBatchInfo(const unsigned char* data, std::size_t size, BatchInfo& info) {
+    PayloadReader in{data, data + size};
+    info.date = in.string();
+    info.fromOffset = in.varint();
+    info.toOffset = in.varint();
+    return in.ok && info.fromOffset <= info.toOffset;
+}
+
+template <typename OnName, typename OnRecord>
+bool decodeBatch(const unsigned char* data, std::size_t size, BatchInfo& info, OnName&& onName,
+                 OnRecord&& onRecord) {
+    PayloadReader in{data, data + size};
+    info.date = in.string();
+    info.fromOffset = in.varint();
+    info.toOffset = in.varint();
+    std::int64_t previousEnd = 0;
+    while (in.ok && !in.done()) {
+        const std::uint64_t tag = in.varint();
+        if (tag == 0) {
+            const auto app = static_cast<AppId>(in.varint());
+            const std::string_view text = in.string();
+            if (in.ok) onName(app, text);
+            continue;
+        }
+        journal::JournalRecord record{};
+        record.app = static_cast<std::uint32_t>(tag - 1);
+        record.startEpoch = previousEnd + unzigzag(in.varint());
+        record.durationSec = static_cast<std::uint32_t>(in.varint());
+        if (!in.ok) break;
+        previousEnd = record.startEpoch + record.durationSec;
+        onRecord(record);
+    }
+    return in.ok;
+}
+
+// 🔌 Blocking socket helpers (EINTR-safe); false on error or a closed peer
+inline bool sendAll(int fd, const unsigned char* data, std::size_t size) {
+    while (size > 0) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL); // Linux: a dead peer is an error, not SIGPIPE
+#else
+        const ssize_t n = ::send(fd, data, size, 0);
+#endif
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+inline bool receiveAll(int fd, unsigned char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t n = ::recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// 📞 Connects to host:port (IPv4 or IPv6) within `timeoutMs` per address; -1 on failure. The socket is
+//    returned blocking, with Nagle off (frames are already one send() each)
+inline int connectTo(const std::string& host, std::uint16_t port, int timeoutMs = 5000) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    if (::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found) != 0) return -1;
+
+    int fd = -1;
+    for (addrinfo* candidate = found; candidate; candidate = candidate->ai_next) {
+        fd = ::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (fd < 0) continue;
+
+        // Non-blocking connect + poll: an unreachable service costs the timeout, not the kernel's ~75 s
+        const int flags = ::fcntl(fd, F_GETFL, 0);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        bool connected = ::connect(fd, candidate->ai_addr, candidate->ai_addrlen) == 0;
+        if (!connected && errno == EINPROGRESS) {
+            pollfd wait{fd, POLLOUT, 0};
+            int error = 0;
+            socklen_t length = sizeof(error);
+            connected = ::poll(&wait, 1, timeoutMs) == 1 &&
+                        ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0;
+        }
+        ::fcntl(fd, F_SETFL, flags);
+        if (connected) break;
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(found);
+    if (fd >= 0) {
+        const int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one)); // macOS: a dead peer is an error, not a signal
+#endif
+    }
+    return fd;
+}
+
+// ⏱️ Send / receive timeout on a blocking socket, so a stalled peer cannot wedge the calling thread
+inline void setIoTimeout(int fd, int seconds) {
+    timeval timeout{seconds, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+} // namespace fleet
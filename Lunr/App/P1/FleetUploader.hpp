@@ -0,0 +1,234 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>          // For std::sort / std::min
+#include <chrono>             // Ship interval and back-off
+#include <condition_variable> // For the timed, stop-aware wait
+#include <cstddef>            // For std::ptrdiff_t
+#include <cstdint>            // Offsets and sequences
+#include <cstdio>             // For std::rename
+#include <filesystem>         // Journal directory scan
+#include <fstream>            // Cursor state file
+#include <mutex>              // Paired with the condition variable
+#include <stop_token>         // For immediate shutdown
+#include <string>             // Paths and dates
+#include <string_view>        // Names borrowed from the mapping
+#include <thread>             // For std::jthread
+#include <utility>            // For std::move
+#include <vector>             // Name table and frame buffer
+
+// 🐧 POSIX
+#include <unistd.h>
+
+#include "FleetProtocol.hpp"   // Frames, batch encoding, sockets
+#include "Instrumentation.hpp" // Upload timings and counters
+#include "MappedFile.hpp"      // Zero-copy journal reads
+#include "SessionJournal.hpp"  // journal::walk
+
+// 🔖 How far this agent's journals have been shipped: a day and the bytes of its file the service has acked.
+//    Persisted so a restart resumes mid-file instead of re-sending the day
+struct FleetCursor {
+    std::string date;         // Journal day being shipped (empty: start from the oldest file present)
+    std::uint64_t offset = 0; // Acknowledged bytes of that day's file
+
+    bool load(const std::string& path) {
+        std::ifstream file(path);
+        return static_cast<bool>(file >> date >> offset);
+    }
+
+    bool save(const std::string& path) const {
+        const std::string temp = path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::trunc);
+            file << date << "\n" << offset << "\n";
+            if (!file.flush()) return false;
+        }
+        return std::rename(temp.c_str(), path.c_str()) == 0; // Never leaves a half-written cursor behind
+    }
+};
+
+// 🛰️ The FleetThread: tails this agent's day journals and ships what is new to the aggregation service
+//    - One persistent connection (Hello once, then Batch / Ack), re-established with back-off after errors
+//    - Each tick ships every journal slice past the cursor, oldest day first, one compact frame per file;
+//      the cursor advances (and is persisted) only once the service acks, so outages and restarts lose
+//      nothing, and a slice re-sent after a lost ack is dropped by the service's offset check
+//    - Only reads the files the FlushThread writes: the observer and analyzer never wait on the network
+class FleetUploader {
+public:
+    FleetUploader(std::string serviceHost, std::uint16_t servicePort, fleet::Identity who, std::string journalPrefix,
+                  std::string cursorFile, Instrumentation& probes,
+                  std::chrono::seconds shipInterval = std::chrono::seconds(60))
+        : host(std::move(serviceHost)), port(servicePort), identity(std::move(who)), cursorPath(std::move(cursorFile)),
+          metrics(probes), interval(shipInterval) {
+        const std::filesystem::path prefix(journalPrefix); // Same "<dir>/lunr_journal_" form as the FlushThread's
+        directory = prefix.has_parent_path() ? prefix.parent_path().string() : ".";
+        filePrefix = prefix.filename().string();
+    }
+
+    FleetUploader(const FleetUploader&) = delete;
+    FleetUploader& operator=(const FleetUploader&) = delete;
+    ~FleetUploader() { stop(); }
+
+    void start() {
+        if (!cursor.load(cursorPath)) cursor = FleetCursor{};
+        worker = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    // 🛑 Wakes the thread, ships one last time (so the final journal batch goes out) and joins it
+    void stop() {
+        worker.request_stop();
+        if (worker.joinable()) worker.join();
+    }
+
+private:
+    static constexpr std::chrono::seconds kMaxBackoff = std::chrono::minutes(15);
+    static constexpr int kIoTimeoutSec = 10;
+
+    void run(std::stop_token stop) {
+        std::unique_lock<std::mutex> lock(wakeupMutex);
+        std::chrono::seconds wait = interval;
+        while (!stop.stop_requested()) {
+            // A failed tick backs off exponentially; the first success returns to the normal interval
+            wait = ship() ? interval : std::min(wait * 2, kMaxBackoff);
+            wakeup.wait_for(lock, stop, wait, [] { return false; });
+        }
+        ship();
+        disconnect();
+    }
+
+    // 🔁 Ships every day from the cursor's onwards; false if the service could not be reached or acked
+    bool ship() {
+        for (const std::string& date : pendingDates()) {
+            if (date != cursor.date) cursor = FleetCursor{date, 0}; // The earlier day is fully acked
+            if (!shipDay(date)) {
+                disconnect();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 📅 Journal dates at or after the cursor's day, oldest first
+    std::vector<std::string> pendingDates() const {
+        std::vector<std::string> dates;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            const std::string name = entry.path().filename().string();
+            if (name.size() != filePrefix.size() + 14 || name.rfind(filePrefix, 0) != 0) continue; // date + ".bin"
+            if (entry.path().extension() != ".bin") continue;
+            std::string date = name.substr(filePrefix.size(), 10);
+            if (date >= cursor.date) dates.push_back(std::move(date));
+        }
+        std::sort(dates.begin(), dates.end()); // YYYY-MM-DD sorts chronologically
+        return dates;
+    }
+
+    // 📤 Sends the unshipped tail of one day's journal as a single Batch and waits for its Ack
+    bool shipDay(const std::string& date) {
+        MappedFile file;
+        if (!file.open(directory + "/" + filePrefix + date + ".bin")) return true; // Nothing (left) to ship
+        if (file.size() <= cursor.offset) return true;
+
+        // Walk the whole file so names announced before the cursor are known, encode only what follows it
+        const unsigned char* base = file.data();
+        const auto shipped = static_cast<std::ptrdiff_t>(cursor.offset);
+        encoder.begin();
+        names.clear();
+        announced.clear();
+        std::uint64_t end = journal::walk(
+            base, file.size(),
+            [&](AppId id, std::string_view name) {
+                if (id >= names.size()) {
+                    names.resize(id + 1);
+                    announced.resize(id + 1, false);
+                }
+                names[id] = name;
+                announced[id] = false; // A later entry (another agent run) renames the id
+            },
+            [&](const journal::JournalRecord& record) {
+                if (reinterpret_cast<const unsigned char*>(&record) - base < shipped) return; // Acked earlier
+                if (record.app < names.size() && !announced[record.app]) {
+                    encoder.name(record.app, names[record.app]);
+                    announced[record.app] = true;
+                }
+                encoder.record(record);
+            });
+        if (end <= cursor.offset) return true;
+
+        if (encoder.records() > 0) {
+            if (fd < 0 && !connect()) return false;
+            frame.clear();
+            fleet::appendFrame(frame, fleet::FrameKind::Batch, ++sequence, encoder.records(),
+                               encoder.finish(date, cursor.offset, end));
+            std::uint64_t acked = 0;
+            {
+                auto timer = metrics.time(Probe::FleetUpload);
+                if (!fleet::sendAll(fd, frame.data(), frame.size()) || !awaitAck(sequence, acked)) return false;
+            }
+            metrics.count(Counter::FleetBatches);
+            metrics.count(Counter::FleetBytes, frame.size());
+            // The service's high-water mark: `end` once merged; elsewhere if it already held part of the slice,
+            // in which case the next tick re-sends from there
+            end = std::min<std::uint64_t>(acked, file.size());
+        }
+        cursor.offset = end; // Also skips slices that held only name entries
+        cursor.save(cursorPath);
+        return true;
+    }
+
+    bool awaitAck(std::uint64_t expected, std::uint64_t& highWater) {
+        unsigned char bytes[sizeof(fleet::FrameHeader)];
+        fleet::FrameHeader header{};
+        if (!fleet::receiveAll(fd, bytes, sizeof(bytes)) || !fleet::readHeader(bytes, header)) return false;
+        std::vector<unsigned char> payload(header.payloadBytes);
+        if (!fleet::receiveAll(fd, payload.data(), payload.size())) return false;
+        if (header.kind != static_cast<std::uint16_t>(fleet::FrameKind::Ack) || header.sequence != expected) {
+            return false;
+        }
+        return fleet::decodeAck(payload.data(), payload.size(), highWater);
+    }
+
+    // 👋 Opens the connection and introduces this agent
+    bool connect() {
+        fd = fleet::connectTo(host, port);
+        if (fd < 0) return false;
+        fleet::setIoTimeout(fd, kIoTimeoutSec);
+        sequence = 0;
+
+        std::vector<unsigned char> hello;
+        fleet::encodeHello(identity, hello);
+        frame.clear();
+        fleet::appendFrame(frame, fleet::FrameKind::Hello, 0, 0, hello);
+        if (fleet::sendAll(fd, frame.data(), frame.size())) return true;
+        disconnect();
+        return false;
+    }
+
+    void disconnect() {
+        if (fd < 0) return;
+        ::close(fd);
+        fd = -1;
+    }
+
+    const std::string host;
+    const std::uint16_t port;
+    const fleet::Identity identity;
+    const std::string cursorPath;
+    Instrumentation& metrics;
+    const std::chrono::seconds interval;
+    std::string directory;  // Where the journals live
+    std::string filePrefix; // Their file-name prefix
+
+    // Uploader thread only (after start())
+    FleetCursor cursor;
+    int fd = -1;
+    std::uint64_t sequence = 0;          // Last Batch sent on this connection
+    fleet::BatchEncoder encoder;         // Reused across ticks
+    std::vector<unsigned char> frame;    // Reused across ticks
+    std::vector<std::string_view> names; // File id → name (views the current mapping)
+    std::vector<bool> announced;         // Ids whose name is already in the current batch
+
+    std::mutex wakeupMutex;
+    std::condition_variable_any wakeup;
+    std::jthread worker; // Declared last: destroyed (and joined) before the state it uses
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <atomic>             // Journal drops, read from the observer thread
+#include <chrono>             // Batch window, sync interval, day bounds
+#include <condition_variable> // For the timed, stop-aware wait
+#include <ctime>              // For std::time_t
+#include <mutex>              // Paired with the condition variable
+#include <stop_token>         // For immediate shutdown
+#include <string>             // For file paths
+#include <thread>             // For std::jthread
+
+#include "AppRegistry.hpp"     // Names for journal string-table entries
+#include "AppSession.hpp"      // SwitchEvent
+#include "EventRing.hpp"       // Lock-free observer → writer handoff
+#include "Instrumentation.hpp" // Batch timings and counters
+#include "LocalDay.hpp"        // Journal file day bounds
+#include "SessionJournal.hpp"  // On-disk encoding
+
+// 💾 The FlushThread: owns the day's journal so no disk I/O ever runs on the observer thread
+//    - The observer submit()s closed sessions into a lock-free ring (never blocks, never allocates)
+//    - Every batch window the writer drains the ring, encodes into the journal's reusable buffer and
+//      hands the whole batch to the kernel in one write(); fsync runs on its own, slower schedule
+//    - Files rotate at local midnight: a session that starts on a new day opens that day's
+//      <prefix>YYYY-MM-DD.bin (the observer keeps running throughout)
+class FlushThread {
+public:
+    static constexpr std::size_t kCapacity = 4096; // Sessions buffered between batches (hours of switching)
+
+    FlushThread(const AppRegistry& names, Instrumentation& probes, std::string filePrefix = "lunr_journal_",
+                std::chrono::milliseconds batchWindow = std::chrono::seconds(2),
+                std::chrono::seconds syncInterval = std::chrono::seconds(60))
+        : registry(names), metrics(probes), prefix(std::move(filePrefix)), window(batchWindow),
+          syncEvery(syncInterval) {}
+
+    FlushThread(const FlushThread&) = delete;
+    FlushThread& operator=(const FlushThread&) = delete;
+    ~FlushThread() { stop(); }
+
+    // 🚀 Opens today's file and starts the writer; returns false if the journal could not be opened
+    //    (the writer still runs and tries again with the next day's file)
+    bool start() {
+        const bool opened = openDay(std::time(nullptr));
+        worker = std::jthread([this](std::stop_token stop) { run(stop); });
+        return opened;
+    }
+
+    // 🛑 Wakes the writer, lets it write and fsync whatever is pending, and joins it
+    void stop() {
+        worker.request_stop();
+        if (worker.joinable()) worker.join();
+    }
+
+    // ➕ Observer side (single producer): false if the writer has fallen a full ring behind
+    bool submit(const SwitchEvent& event) noexcept { return pending.tryPush(event); }
+
+    // 📉 Sessions that will never be journaled: rejected by a full ring, or dropped by a failed write
+    std::size_t dropped() const noexcept {
+        return pending.dropped() + unwritten.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run(std::stop_token stop) {
+        std::unique_lock<std::mutex> lock(wakeupMutex);
+        auto lastSync = std::chrono::steady_clock::now();
+        while (!stop.stop_requested()) {
+            wakeup.wait_for(lock, stop, window, [] { return false; });
+            writeBatch();
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastSync >= syncEvery) {
+                auto timer = metrics.time(Probe::FlushSync);
+                journal.sync();
+                lastSync = now;
+            }
+        }
+        writeBatch(); // Final batch: includes the session main closed just before stop()
+        journal.sync();
+        journal.close();
+    }
+
+    void writeBatch() {
+        auto timer = metrics.time(Probe::FlushBatch);
+        const std::size_t drained = pending.drain([this](const SwitchEvent& event) {
+            const std::time_t start = Clock::to_time_t(event.startTime);
+            if (!day.contains(start)) { // Crossed local midnight (or no file yet)
+                journal.flush();
+                journal.sync();
+                openDay(start);
+            }
+            journal.add(event, registry);
+        });
+        journal.flush(); // One write() for the whole batch
+        unwritten.store(journal.dropped(), std::memory_order_relaxed);
+        if (drained == 0) return;
+        metrics.count(Counter::FlushBatches);
+        metrics.count(Counter::EventsFlushed, drained);
+    }
+
+    // 📅 Opens the journal for the local day containing `t` and caches that day's [begin, end) bounds
+    bool openDay(std::time_t t) {
+        day = localDayOf(t);
+        metrics.count(Counter::DayRotations);
+        return journal.open(prefix + day.date + ".bin");
+    }
+
+    const AppRegistry& registry;
+    Instrumentation& metrics;
+    const std::string prefix;
+    const std::chrono::milliseconds window;
+    const std::chrono::seconds syncEvery;
+
+    EventRing<SwitchEvent, kCapacity> pending;
+    SessionJournal journal; // Writer thread only (after start())
+    std::atomic<std::size_t> unwritten{0}; // journal.dropped() as of the last batch (written by the writer)
+    LocalDay day; // Bounds of the open journal's day
+
+    std::mutex wakeupMutex;
+    std::condition_variable_any wakeup;
+    std::jthread worker; // Declared last: destroyed (and joined) before the state it uses
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <array>   // Fixed-size bucket and ring storage
+#include <cstdint> // For fixed-width counters
+#include <chrono>  // For std::chrono::seconds
+#include <bit>     // For std::bit_width
+
+// 📊 Fixed-size, log-bucketed histogram of focus durations (constant memory per app)
+//    - Bucket 0 holds 0s; every power of two [2^e, 2^(e+1)) is split into 4 linear sub-buckets
+//    - Relative error of a reported percentile is therefore at most ~25%, and anything ≥ 2^kMaxExponent saturates
+class FocusHistogram {
+public:
+    static constexpr int kSubBuckets = 4;    // Sub-buckets per power of two
+    static constexpr int kMaxExponent = 20;  // 2^20 s ≈ 12 days: far beyond any single focus session
+    static constexpr int kBuckets = 1 + kMaxExponent * kSubBuckets;
+
+    // ➕ Counts one focus session
+    void record(std::chrono::seconds duration) {
+        ++buckets[bucketFor(duration.count())];
+        ++total;
+    }
+
+    std::uint64_t count() const { return total; }
+
+    // 🎯 Duration at or below which `fraction` (0..1) of sessions fall, reported as the bucket's upper bound
+    std::chrono::seconds percentile(double fraction) const {
+        if (total == 0) return std::chrono::seconds(0);
+        if (fraction < 0.0) fraction = 0.0;
+        if (fraction > 1.0) fraction = 1.0;
+
+        // Rank of the target sample (1-based, rounded up so p100 is the last sample)
+        std::uint64_t rank = static_cast<std::uint64_t>(fraction * static_cast<double>(total) + 0.999999);
+        if (rank == 0) rank = 1;
+
+        std::uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) return std::chrono::seconds(upperBound(i));
+        }
+        return std::chrono::seconds(upperBound(kBuckets - 1));
+    }
+
+    // 🔗 Adds another histogram's counts into this one (used when combining partial aggregates)
+    void merge(const FocusHistogram& other) {
+        for (int i = 0; i < kBuckets; ++i) buckets[i] += other.buckets[i];
+        total += other.total;
+    }
+
+private:
+    static int bucketFor(long long secs) {
+        if (secs <= 0) return 0;
+        const auto v = static_cast<std::uint64_t>(secs);
+
+        const int exponent = static_cast<int>(std::bit_width(v)) - 1; // floor(log2 v)
+        if (exponent >= kMaxExponent) return kBuckets - 1;
+
+        // Next two bits below the leading one select the linear sub-bucket
+        const int sub = exponent >= 2 ? static_cast<int>((v >> (exponent - 2)) & 0x3)
+                                : static_cast<int>((v << (2 - exponent)) & 0x3);
+        return 1 + exponent * kSubBuckets + sub;
+    }
+
+    static long long upperBound(int bucket) {
+        if (bucket == 0) return 0;
+        const int exponent = (bucket - 1) / kSubBuckets;
+        const long long sub = (bucket - 1) % kSubBuckets;
+
+        // Sub-bucket `sub` spans [(4+sub)·2^e/4, (5+sub)·2^e/4); below 2^2 each one holds a single value
+        if (exponent < 2) return ((kSubBuckets + sub) << exponent) >> 2;
+        return (((kSubBuckets + sub + 1) << exponent) >> 2) - 1;
+    }
+
+    std::array<std::uint32_t, kBuckets> buckets{}; // Per-bucket session counts
+    std::uint64_t total = 0;                       // Sum of all buckets
+};
+
+// 🕘 Ring of the last N raw focus durations, oldest overwritten first
+template <std::size_t N>
+class RecentFocus {
+public:
+    void record(std::chrono::seconds duration) {
+        values[next] = static_cast<std::uint32_t>(duration.count());
+        next = (next + 1) % N;
+        if (filled < N) ++filled;
+    }
+
+    std::size_t size() const { return filled; }
+
+    // 🔍 i = 0 is the most recent duration
+    std::chrono::seconds operator[](std::size_t i) const {
+        return std::chrono::seconds(values[(next + N - 1 - i) % N]);
+    }
+
+private:
+    std::array<std::uint32_t, N> values{};
+    std::size_t next = 0;   // Slot for the next write
+    std::size_t filled = 0; // Valid entries (≤ N)
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <atomic>      // Contribution count published by the analyzer
+#include <chrono>      // Session boundaries
+#include <cstdint>     // Seconds credited to rules
+#include <ctime>       // Local day / minute for rule context
+#include <string_view> // Alert prefixes
+
+#include "AppSession.hpp"         // ObserverState times, SwitchEvent
+#include "CategoryClassifier.hpp" // App → category
+#include "CategoryCounters.hpp"   // Live per-category seconds
+#include "EnforcementEngine.hpp"  // Rules evaluated at every switch
+#include "EventRing.hpp"          // Handoff to the analyzer
+#include "FlushThread.hpp"        // Journal writer
+#include "FocusSource.hpp"        // Where focus comes from, where blocks act
+#include "Instrumentation.hpp"    // Hot-path probes and counters
+#include "ReportWriter.hpp"       // Block and warning alerts
+
+// 🧭 Observer state shared by every driver (event-driven, polling, replay)
+struct ObserverState {
+    AppId currentApp = AppRegistry::kUnknown; // App that currently has focus
+    Clock::time_point currentStart;           // When it gained focus
+    bool away = false;                        // No open session: user idle, screen locked or asleep
+    bool locked = false;                      // Screen lock reported (event mode)
+    bool asleep = false;                      // Displays or system asleep (event mode)
+    Clock::time_point enforceAt = Clock::time_point::max(); // When the focused app's rule allowance runs out
+};
+
+// 📆 Local day key (budgets reset when it changes)
+inline int dayKeyOf(const std::tm& local) { return local.tm_year * 400 + local.tm_yday; }
+
+// 👁️ The observer core: session boundaries, the handoff to the analyzer and journal, and enforcement.
+//    Drivers decide *when* focus changed (NSWorkspace notifications, sampling, a replayed journal) and call
+//    recordSwitch / markAway / markBack; everything downstream is the same for all of them.
+//    Observer thread only.
+class FocusObserver {
+public:
+    FocusObserver(FocusSource& focusSource, EventRing<SwitchEvent, 1024>& analyzerRing, FlushThread* journalWriter,
+                  CategoryClassifier& categories, CategoryCounters& categorySeconds, EnforcementEngine& rules,
+                  const std::atomic<std::uint32_t>& contributions, Instrumentation& probes)
+        : source(&focusSource), switchEvents(analyzerRing), flushThread(journalWriter), classifier(categories),
+          categoryUsage(categorySeconds), enforcement(rules), contributionsToday(contributions), metrics(probes) {}
+
+    FocusObserver(const FocusObserver&) = delete;
+    FocusObserver& operator=(const FocusObserver&) = delete;
+
+    FocusSource& focusSource() { return *source; }
+    void setSource(FocusSource& focusSource) { source = &focusSource; } // Before the driver starts
+    void setAlerts(bool print) { alerts = print; }                      // Block / warning lines on stdout
+
+    // 🍏 Id of the app that has focus now, from the current source
+    AppId frontmost() { return source->frontmost(); }
+
+    // 🔒 What a rule decision needs besides the engine's own totals
+    EnforcementContext enforcementContext(Clock::time_point now) const {
+        std::time_t t = Clock::to_time_t(now);
+        std::tm local{};
+        localtime_r(&t, &local);
+        return {dayKeyOf(local), local.tm_wday, local.tm_hour * 60 + local.tm_min,
+                static_cast<std::uint32_t>(local.tm_sec), contributionsToday.load(std::memory_order_relaxed)};
+    }
+
+    // ⏹️ Closes the focused app's session at `now` and hands it to the analyzer
+    void closeCurrentSession(ObserverState& state, Clock::time_point now) {
+        Seconds duration = std::chrono::duration_cast<Seconds>(now - state.currentStart);
+        SwitchEvent event{state.currentApp, classifier.categoryOf(state.currentApp), state.currentStart, duration};
+        {
+            auto timer = metrics.time(Probe::SessionHandoff);
+            switchEvents.tryPush(event);                  // Never blocks
+            if (flushThread) flushThread->submit(event);  // Journaled by the flush thread's next batch
+            categoryUsage.add(event.category, static_cast<std::uint64_t>(duration.count())); // Own cache line
+        }
+        enforcement.credit(event.app, event.category, static_cast<std::uint32_t>(duration.count()),
+                           enforcementContext(now).dayKey);
+    }
+
+    // 🚫 Checks the focused app against the rules; hides it on a block and re-arms the allowance deadline
+    void enforceFocus(ObserverState& state, Clock::time_point now) {
+        state.enforceAt = Clock::time_point::max();
+        if (enforcement.size() == 0 || state.away) return;
+
+        EnforcementContext context = enforcementContext(now);
+        const Seconds open = std::chrono::duration_cast<Seconds>(now - state.currentStart);
+        context.openSeconds = static_cast<std::uint32_t>(open.count()); // Non-zero only on deadline re-checks
+        const UsageCategory category = classifier.categoryOf(state.currentApp);
+        EnforcementDecision decision;
+        {
+            auto timer = metrics.time(Probe::Enforce);
+            decision = enforcement.evaluate(state.currentApp, category, context);
+        }
+
+        if (decision.action == RuleAction::Block) {
+            metrics.count(Counter::RuleBlocks);
+            if (alerts) alert("\n🚫 Access Denied — ", decision.rule);
+            source->hideFrontmost(); // Sites are enforced by hiding their browser
+            return;                  // The next activation is evaluated afresh
+        }
+        if (decision.action == RuleAction::Warn) {
+            metrics.count(Counter::RuleWarnings);
+            if (alerts) alert("\n⚠️ Lunr: ", decision.rule);
+        }
+        if (decision.allowanceSec > 0) {
+            state.enforceAt = now + Seconds(decision.allowanceSec);
+            source->scheduleRecheck(Seconds(decision.allowanceSec));
+        }
+    }
+
+    // 💤 Closes the open session at `lastActivity` so away time is never credited (no-op if already away)
+    void markAway(ObserverState& state, Clock::time_point lastActivity) {
+        if (state.away) return;
+        if (lastActivity < state.currentStart) lastActivity = state.currentStart;
+        metrics.count(Counter::IdlePauses);
+        closeCurrentSession(state, lastActivity);
+        state.away = true;
+    }
+
+    // ☀️ Opens a fresh session for `frontApp` once the user is back (no-op if not away)
+    void markBack(ObserverState& state, AppId frontApp, Clock::time_point now) {
+        if (!state.away) return;
+        state.away = false;
+        state.currentApp = frontApp;
+        state.currentStart = now;
+        enforceFocus(state, now);
+    }
+
+    // 🔀 Records a switch to `frontApp` that happened at `now` (no-op if focus did not change)
+    void recordSwitch(ObserverState& state, AppId frontApp, Clock::time_point now) {
+        if (state.away) { // Any activation means the user is back
+            if (!state.locked && !state.asleep) markBack(state, frontApp, now);
+            return;
+        }
+        if (frontApp == state.currentApp) return;
+
+        metrics.count(Counter::Switches);
+        closeCurrentSession(state, now);
+
+        // Start new session
+        state.currentApp = frontApp;
+        state.currentStart = now;
+        enforceFocus(state, now);
+    }
+
+private:
+    // 📣 One alert line, formatted in the fixed buffer and written in one call (no iostreams on this thread)
+    void alert(std::string_view prefix, int rule) {
+        alertOut << prefix;
+        enforcement.describe(rule, alertOut);
+        alertOut << '\n';
+        alertOut.flush();
+    }
+
+    FocusSource* source;
+    EventRing<SwitchEvent, 1024>& switchEvents;
+    FlushThread* flushThread; // Null: sessions are not journaled (replay)
+    CategoryClassifier& classifier;
+    CategoryCounters& categoryUsage;
+    EnforcementEngine& enforcement;
+    const std::atomic<std::uint32_t>& contributionsToday;
+    Instrumentation& metrics;
+    bool alerts = true;
+    ReportWriter alertOut; // stdout
+};
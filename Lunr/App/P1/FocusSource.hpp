@@ -0,0 +1,23 @@
+#pragma once
+
+#include "AppRegistry.hpp" // AppId
+#include "AppSession.hpp"  // Seconds
+
+// 🎛️ Where focus comes from and where enforcement acts
+//    - NSWorkspace backend (SystemObserver.mm): the live desktop, AppKit only
+//    - ReplaySource (ReplaySource.hpp): recorded journals at accelerated speed, portable
+//    The observer core (FocusObserver.hpp) only talks to this interface, so it runs wherever a backend does
+class FocusSource {
+public:
+    virtual ~FocusSource() = default;
+
+    // 🍏 Interned id of the app that has focus now
+    virtual AppId frontmost() = 0;
+
+    // 🚫 Enforcement action: take focus away from the blocked frontmost app
+    virtual void hideFrontmost() = 0;
+
+    // ⏰ Asks to be woken `delay` from now to re-check rules for the focused app (no-op for sources whose
+    //    driver checks ObserverState::enforceAt itself)
+    virtual void scheduleRecheck(Seconds delay) { (void)delay; }
+};
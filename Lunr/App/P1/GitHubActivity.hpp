@@ -0,0 +1,191 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>          // For std::max
+#include <chrono>             // Poll interval and rate-limit resets
+#include <condition_variable> // For the timed, stop-aware wait
+#include <cstdint>            // For counters and epochs
+#include <cstdio>             // For std::rename
+#include <ctime>              // Local midnight for "today"
+#include <fstream>            // Cursor state file
+#include <memory>             // Owned transport
+#include <mutex>              // Paired with the condition variable
+#include <stop_token>         // For immediate shutdown
+#include <string>             // User, ETag, paths
+#include <string_view>        // Borrowed request parameters
+#include <thread>             // For std::jthread
+#include <vector>             // Events of one response
+
+#include "EventRing.hpp"       // Lock-free handoff to the analyzer
+#include "Instrumentation.hpp" // Poll counters and latency
+
+// 🐙 Contributions counted from GitHub activity (one day's worth in the analyzer, a delta in flight)
+struct ContributionCounts {
+    std::uint32_t commits = 0;      // Distinct commits pushed
+    std::uint32_t pullRequests = 0; // Pull requests opened
+    std::uint32_t comments = 0;     // Issue, review and commit comments
+
+    void add(const ContributionCounts& other) {
+        commits += other.commits;
+        pullRequests += other.pullRequests;
+        comments += other.comments;
+    }
+
+    std::uint32_t total() const { return commits + pullRequests + comments; }
+};
+
+// 📨 What the poller hands the analyzer (same SPSC pattern as SwitchEvent, separate ring)
+struct ContributionEvent {
+    std::int64_t polledEpoch = 0; // When the delta was observed
+    ContributionCounts delta;
+};
+
+// 🧾 One activity event, already classified by the transport
+struct GitHubEvent {
+    std::int64_t createdEpoch = 0;
+    ContributionCounts counts; // All zero for event types that are not contributions
+};
+
+// 📬 Parsed response of one conditional GET
+struct GitHubResponse {
+    int status = 0;                  // HTTP status (200, 304, 403, ...); 0 if the request never completed
+    std::string etag;                // Validator for the next If-None-Match
+    int pollIntervalSec = 0;         // X-Poll-Interval: GitHub's minimum spacing between polls
+    int rateRemaining = -1;          // X-RateLimit-Remaining (-1 if absent)
+    std::int64_t rateResetEpoch = 0; // X-RateLimit-Reset
+    std::vector<GitHubEvent> events; // 200 only, newest first
+};
+
+// 🌐 Pluggable HTTP side (NSURLSession in the agent); implementations keep one keep-alive connection
+//    and must send If-None-Match whenever `etag` is non-empty
+class GitHubTransport {
+public:
+    virtual ~GitHubTransport() = default;
+    virtual GitHubResponse fetchEvents(std::string_view user, std::string_view etag) = 0;
+};
+
+// 🔖 Where the last poll left off: the ETag for conditional requests and the newest event already counted.
+//    Persisted so a restart neither re-counts events nor spends a full 200 on its first poll
+struct GitHubCursor {
+    std::string etag;
+    std::int64_t sinceEpoch = 0;
+
+    bool load(const std::string& path) {
+        std::ifstream file(path);
+        return static_cast<bool>(std::getline(file, etag) && file >> sinceEpoch);
+    }
+
+    bool save(const std::string& path) const {
+        const std::string temp = path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::trunc);
+            file << etag << "\n" << sinceEpoch << "\n";
+            if (!file.flush()) return false;
+        }
+        return std::rename(temp.c_str(), path.c_str()) == 0; // Never leaves a half-written cursor behind
+    }
+};
+
+// 🐙 The GitHubThread: polls a user's public activity on its own thread and pushes contribution deltas
+//    into `sink` for the analyzer
+//    - Common case is one 304 per poll (If-None-Match), which GitHub does not count against the rate limit
+//    - Only events newer than the cursor (and from today) are counted, so overlapping pages never double count
+//    - Spacing honours X-Poll-Interval, and an exhausted rate limit parks the thread until the reset time
+class GitHubPoller {
+public:
+    GitHubPoller(std::unique_ptr<GitHubTransport> client, std::string login, std::string cursorFile,
+                 EventRing<ContributionEvent, 64>& contributions, Instrumentation& probes,
+                 std::chrono::seconds pollInterval = std::chrono::hours(1))
+        : transport(std::move(client)), user(std::move(login)), cursorPath(std::move(cursorFile)),
+          sink(contributions), metrics(probes), interval(pollInterval) {}
+
+    GitHubPoller(const GitHubPoller&) = delete;
+    GitHubPoller& operator=(const GitHubPoller&) = delete;
+    ~GitHubPoller() { stop(); }
+
+    void start() {
+        if (!cursor.load(cursorPath)) cursor = GitHubCursor{};
+        worker = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    void stop() {
+        worker.request_stop();
+        if (worker.joinable()) worker.join();
+    }
+
+private:
+    void run(std::stop_token stop) {
+        std::unique_lock<std::mutex> lock(wakeupMutex);
+        while (!stop.stop_requested()) {
+            const std::chrono::seconds wait = poll();
+            wakeup.wait_for(lock, stop, wait, [] { return false; });
+        }
+    }
+
+    // 🔁 One conditional request; returns how long to wait before the next one
+    std::chrono::seconds poll() {
+        GitHubResponse response;
+        {
+            auto timer = metrics.time(Probe::GitHubPoll);
+            response = transport->fetchEvents(user, cursor.etag);
+        }
+        metrics.count(Counter::GitHubPolls);
+
+        const std::int64_t now = epochNow();
+        std::chrono::seconds wait = std::max(interval, std::chrono::seconds(response.pollIntervalSec));
+        if (response.rateRemaining == 0 && response.rateResetEpoch > now) {
+            wait = std::max(wait, std::chrono::seconds(response.rateResetEpoch - now));
+        }
+
+        if (response.status == 304) {
+            metrics.count(Counter::GitHubUnchanged);
+            return wait;
+        }
+        if (response.status != 200) return wait; // Network error, 403, 5xx: try again next interval
+
+        const std::int64_t today = startOfToday(now);
+        ContributionCounts delta;
+        std::int64_t newest = cursor.sinceEpoch;
+        for (const GitHubEvent& event : response.events) {
+            if (event.createdEpoch <= cursor.sinceEpoch) continue; // Already counted by an earlier poll
+            newest = std::max(newest, event.createdEpoch);
+            if (event.createdEpoch >= today) delta.add(event.counts);
+        }
+
+        cursor.etag = response.etag;
+        cursor.sinceEpoch = newest;
+        cursor.save(cursorPath);
+        if (delta.total() > 0) sink.tryPush(ContributionEvent{now, delta});
+        return wait;
+    }
+
+    static std::int64_t epochNow() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // 📅 Local midnight of the day containing `epoch`
+    static std::int64_t startOfToday(std::int64_t epoch) {
+        std::time_t t = static_cast<std::time_t>(epoch);
+        std::tm local{};
+        localtime_r(&t, &local);
+        local.tm_hour = 0;
+        local.tm_min = 0;
+        local.tm_sec = 0;
+        local.tm_isdst = -1;
+        return static_cast<std::int64_t>(std::mktime(&local));
+    }
+
+    std::unique_ptr<GitHubTransport> transport;
+    const std::string user;
+    const std::string cursorPath;
+    EventRing<ContributionEvent, 64>& sink; // Producer side (this thread only)
+    Instrumentation& metrics;
+    const std::chrono::seconds interval;
+    GitHubCursor cursor; // Poller thread only (after start())
+
+    std::mutex wakeupMutex;
+    std::condition_variable_any wakeup;
+    std::jthread worker; // Declared last: destroyed (and joined) before the state it uses
+};
@@ -0,0 +1,311 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>     // For sorting and range lookup
+#include <atomic>        // Work distribution across workers
+#include <cstdint>       // For counters
+#include <cstdlib>       // For std::strtol
+#include <filesystem>    // For scanning the log directory
+#include <fstream>       // For legacy text logs
+#include <string>        // Dates and app names
+#include <string_view>   // Zero-copy names from mapped journals
+#include <thread>        // Worker threads for parallel aggregation
+#include <unordered_map> // Name → aggregate slot
+#include <utility>       // For std::pair
+#include <vector>        // Day list and results
+
+#include "AppSession.hpp"     // Clock aliases, AppSession
+#include "BehaviorStats.hpp"  // Same aggregates as the live analyzer
+#include "MappedFile.hpp"     // RAII mmap
+#include "SessionJournal.hpp" // Journal layout + in-place walker
+
+// 📊 Usage of one app over a queried range
+struct AppUsage {
+    std::string app;            // Display name
+    Seconds total = Seconds(0); // Accumulated focus time
+    std::uint64_t sessions = 0; // Focus sessions (a legacy day counts as one session per app)
+};
+
+// 🧮 Aggregate over a slice of history, built from the live analyzer's types (AppSession + BehaviorStats)
+//    Ids here are local to the aggregate; `names[id]` resolves them
+struct HistoryAggregate {
+    std::vector<std::string> names;              // Aggregate-local id → app name
+    std::unordered_map<std::string, AppId> ids;  // App name → aggregate-local id
+    std::vector<AppSession> sessions;            // Indexed by aggregate-local id
+    BehaviorStats stats;
+
+    // 🆔 Id for `name`, created on first sight
+    AppId idFor(std::string_view name) {
+        auto found = ids.find(std::string(name));
+        if (found != ids.end()) return found->second;
+        const auto id = static_cast<AppId>(names.size());
+        names.emplace_back(name);
+        ids.emplace(names.back(), id);
+        sessions.push_back(AppSession{id, UsageCategory::Other, Clock::time_point(), Seconds(0), FocusHistogram(), RecentFocus<16>()});
+        return id;
+    }
+
+    // ➕ Same fold as the live analyzer's applySwitchEvent()
+    void record(AppId id, Seconds duration) {
+        AppSession& session = sessions[id];
+        session.totalDuration += duration;
+        session.focusHistogram.record(duration);
+        session.recentFocus.record(duration);
+        stats.record(session, duration);
+    }
+
+    // 🔗 Reduction step: folds another partial into this one (remapping its ids through names)
+    void merge(const HistoryAggregate& other) {
+        for (AppId otherId = 0; otherId < other.sessions.size(); ++otherId) {
+            const AppSession& from = other.sessions[otherId];
+            AppSession& into = sessions[idFor(other.names[otherId])];
+            into.totalDuration += from.totalDuration;
+            into.focusHistogram.merge(from.focusHistogram);
+        }
+        stats.merge(other.stats);
+
+        // Re-derive the top app from merged per-app totals (O(apps), once per merge)
+        stats.topApp = AppRegistry::kUnknown;
+        stats.topDuration = Seconds(0);
+        for (const AppSession& session : sessions) {
+            if (session.totalDuration > stats.topDuration) {
+                stats.topDuration = session.totalDuration;
+                stats.topApp = session.app;
+            }
+        }
+    }
+};
+
+// 📚 Multi-day history: mmaps every `lunr_journal_YYYY-MM-DD.bin` in a directory and imports legacy
+//    `lunr_log_YYYY-MM-DD.log` text files for days that have no journal. Queries take inclusive
+//    "YYYY-MM-DD" bounds and walk the mapped records in place.
+class HistoryReader {
+public:
+    // 📂 Loads every recognised file in `directory`; returns the number of days available
+    std::size_t openDirectory(const std::string& directory) {
+        days.clear();
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (!entry.is_regular_file(error)) continue;
+            const std::string file = entry.path().filename().string();
+
+            if (std::string date; matchDated(file, "lunr_journal_", ".bin", date)) {
+                MappedFile mapped;
+                if (!mapped.open(entry.path().string())) continue;
+                if (!journal::isValid(mapped.data(), mapped.size())) continue;
+                Day& day = dayFor(date);
+                day.journal = std::move(mapped);
+                day.legacy.clear(); // The journal is the authoritative record for its day
+            } else if (matchDated(file, "lunr_log_", ".log", date)) {
+                Day& day = dayFor(date);
+                if (!day.journal.isOpen()) day.legacy = importLegacyLog(entry.path().string());
+            }
+        }
+
+        std::sort(days.begin(), days.end(), [](const Day& a, const Day& b) { return a.date < b.date; });
+        return days.size();
+    }
+
+    std::size_t dayCount() const { return days.size(); }
+
+    // 📅 Dates available, oldest first
+    std::vector<std::string> dates() const {
+        std::vector<std::string> result;
+        result.reserve(days.size());
+        for (const auto& day : days) result.push_back(day.date);
+        return result;
+    }
+
+    // 🔁 Calls fn(std::string_view app, Seconds duration, std::int64_t startEpoch) for every session in
+    //    [from, to]; `app` views the mapped file (or the legacy import) and stays valid while the reader lives
+    template <typename Fn>
+    void forEachSession(std::string_view from, std::string_view to, Fn&& fn) const {
+        std::vector<std::string_view> names; // File-local id → name, rebuilt per file
+        for (const Day* day : range(from, to)) {
+            if (day->journal.isOpen()) {
+                names.clear();
+                journal::walk(
+                    day->journal.data(), day->journal.size(),
+                    [&](AppId id, std::string_view name) {
+                        if (id >= names.size()) names.resize(id + 1);
+                        names[id] = name;
+                    },
+                    [&](const journal::JournalRecord& record) {
+                        std::string_view name = record.app < names.size() ? names[record.app] : std::string_view();
+                        fn(name, Seconds(record.durationSec), record.startEpoch);
+                    });
+            } else {
+                for (const auto& [app, total] : day->legacy) fn(std::string_view(app), total, std::int64_t(0));
+            }
+        }
+    }
+
+    // 📊 Total focus time per app over [from, to], most used first
+    std::vector<AppUsage> usageByApp(std::string_view from, std::string_view to) const {
+        std::vector<AppUsage> usage;
+        std::unordered_map<std::string_view, std::size_t> slotOf; // Keys view mapped memory: no copies
+        std::vector<std::size_t> localSlot;                       // File-local id → slot in `usage`
+
+        auto slotFor = [&](std::string_view name) {
+            auto [it, inserted] = slotOf.try_emplace(name, usage.size());
+            if (inserted) usage.push_back(AppUsage{std::string(name), Seconds(0), 0});
+            return it->second;
+        };
+
+        for (const Day* day : range(from, to)) {
+            if (day->journal.isOpen()) {
+                localSlot.clear();
+                journal::walk(
+                    day->journal.data(), day->journal.size(),
+                    [&](AppId id, std::string_view name) { // Hash each name once per file, not per record
+                        if (id >= localSlot.size()) localSlot.resize(id + 1, kNoSlot);
+                        localSlot[id] = slotFor(name);
+                    },
+                    [&](const journal::JournalRecord& record) {
+                        if (record.app >= localSlot.size() || localSlot[record.app] == kNoSlot) return;
+                        AppUsage& app = usage[localSlot[record.app]];
+                        app.total += Seconds(record.durationSec);
+                        ++app.sessions;
+                    });
+            } else {
+                for (const auto& [name, total] : day->legacy) {
+                    AppUsage& app = usage[slotFor(name)];
+                    app.total += total;
+                    ++app.sessions;
+                }
+            }
+        }
+
+        std::sort(usage.begin(), usage.end(), [](const AppUsage& a, const AppUsage& b) { return a.total > b.total; });
+        return usage;
+    }
+
+    // 🏆 The `n` most used apps over [from, to]
+    std::vector<AppUsage> topApps(std::string_view from, std::string_view to, std::size_t n) const {
+        std::vector<AppUsage> usage = usageByApp(from, to);
+        if (usage.size() > n) usage.resize(n);
+        return usage;
+    }
+
+    // ⚡ Parallel aggregate over [from, to]: workers pull days from a shared counter, each folds into its own
+    //    partial HistoryAggregate, and the partials are merged at the end. `threads` = 0 uses every core.
+    HistoryAggregate aggregate(std::string_view from, std::string_view to, unsigned threads = 0) const {
+        const std::vector<const Day*> selected = range(from, to);
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, selected.size())));
+
+        std::vector<HistoryAggregate> partials(threads);
+        std::atomic<std::size_t> nextDay{0};
+
+        auto work = [&](HistoryAggregate& partial) {
+            std::vector<AppId> localId; // File-local id → partial id
+            for (std::size_t i = nextDay.fetch_add(1); i < selected.size(); i = nextDay.fetch_add(1)) {
+                const Day& day = *selected[i];
+                if (day.journal.isOpen()) {
+                    localId.clear();
+                    journal::walk(
+                        day.journal.data(), day.journal.size(),
+                        [&](AppId id, std::string_view name) {
+                            if (id >= localId.size()) localId.resize(id + 1, kNoId);
+                            localId[id] = partial.idFor(name);
+                        },
+                        [&](const journal::JournalRecord& record) {
+                            if (record.app >= localId.size() || localId[record.app] == kNoId) return;
+                            partial.record(localId[record.app], Seconds(record.durationSec));
+                        });
+                } else {
+                    for (const auto& [name, total] : day.legacy) partial.record(partial.idFor(name), total);
+                }
+            }
+        };
+
+        // The calling thread works too; only threads - 1 extra are spawned
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t) workers.emplace_back(work, std::ref(partials[t]));
+        work(partials[0]);
+        for (auto& worker : workers) worker.join();
+
+        for (unsigned t = 1; t < threads; ++t) partials[0].merge(partials[t]);
+        return std::move(partials[0]);
+    }
+
+    // 🗂️ Totals per category over [from, to]; classify(std::string_view app) returns the category label
+    template <typename Classify>
+    std::vector<std::pair<std::string, Seconds>> categoryTotals(std::string_view from, std::string_view to,
+                                                                Classify&& classify) const {
+        std::vector<std::pair<std::string, Seconds>> totals;
+        for (const AppUsage& app : usageByApp(from, to)) { // Classify per app, not per record
+            std::string category(classify(std::string_view(app.app)));
+            auto it = std::find_if(totals.begin(), totals.end(), [&](const auto& t) { return t.first == category; });
+            if (it == totals.end()) {
+                totals.emplace_back(std::move(category), app.total);
+            } else {
+                it->second += app.total;
+            }
+        }
+        std::sort(totals.begin(), totals.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+        return totals;
+    }
+
+private:
+    static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+    static constexpr AppId kNoId = static_cast<AppId>(-1);
+
+    struct Day {
+        std::string date;                                    // "YYYY-MM-DD"
+        MappedFile journal;                                  // Binary journal (preferred)
+        std::vector<std::pair<std::string, Seconds>> legacy; // Imported text totals when no journal exists
+    };
+
+    // 🔎 "prefixYYYY-MM-DDsuffix" → date
+    static bool matchDated(const std::string& file, std::string_view prefix, std::string_view suffix,
+                           std::string& date) {
+        if (file.size() != prefix.size() + 10 + suffix.size()) return false;
+        if (file.compare(0, prefix.size(), prefix) != 0) return false;
+        if (file.compare(file.size() - suffix.size(), suffix.size(), suffix) != 0) return false;
+        date = file.substr(prefix.size(), 10);
+        return date[4] == '-' && date[7] == '-';
+    }
+
+    // 📜 Parses the CSV-like text log written by writeDailyLog(): "App,Xm Ys" per line after the date header
+    static std::vector<std::pair<std::string, Seconds>> importLegacyLog(const std::string& path) {
+        std::vector<std::pair<std::string, Seconds>> totals;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            const auto comma = line.rfind(','); // App names may contain commas; the duration never does
+            if (comma == std::string::npos) continue;
+
+            const char* cursor = line.c_str() + comma + 1;
+            char* end = nullptr;
+            long mins = std::strtol(cursor, &end, 10);
+            if (end == cursor || *end != 'm') continue;
+            cursor = end + 1;
+            long secs = std::strtol(cursor, &end, 10);
+            if (end == cursor || *end != 's') continue;
+
+            totals.emplace_back(line.substr(0, comma), Seconds(mins * 60 + secs));
+        }
+        return totals;
+    }
+
+    Day& dayFor(const std::string& date) {
+        for (auto& day : days) {
+            if (day.date == date) return day;
+        }
+        days.push_back(Day{date, MappedFile(), {}});
+        return days.back();
+    }
+
+    // 📅 Days whose date falls in [from, to] (days are sorted, so this is a binary search)
+    std::vector<const Day*> range(std::string_view from, std::string_view to) const {
+        auto first = std::lower_bound(days.begin(), days.end(), from,
+                                      [](const Day& day, std::string_view d) { return day.date < d; });
+        std::vector<const Day*> result;
+        for (auto it = first; it != days.end() && std::string_view(it->date) <= to; ++it) result.push_back(&*it);
+        return result;
+    }
+
+    std::vector<Day> days; // Sorted by date after openDirectory()
+};
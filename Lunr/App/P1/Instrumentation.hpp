@@ -0,0 +1,183 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <array>   // Fixed metric tables
+#include <atomic>  // Lock-free counters (each probe has a single writer thread)
+#include <bit>     // For std::bit_width
+#include <chrono>  // For steady_clock timing
+#include <cstdint> // For fixed-width counters
+#include <ostream> // For dump()
+
+// 📍 Timed call sites on the observer, analyzer, flush, GitHub and fleet threads
+enum class Probe : std::size_t {
+    FrontmostApp,   // getFrontmostApp() (observer thread)
+    SessionHandoff, // closeCurrentSession(): ring push (observer thread)
+    FlushBatch,     // Drain + one journal write() per batch (flush thread)
+    FlushSync,      // Periodic fsync of the open journal (flush thread)
+    TabQuery,       // Browser active-tab lookup, e.g. AppleScript (observer thread)
+    AnalyzerDrain,  // Ring drain + aggregate update (analyzer thread)
+    Analyze,        // analyzeBehavior() (analyzer thread)
+    Checkpoint,     // Snapshot encode + fsync + rename (analyzer thread)
+    GitHubPoll,     // One conditional request to the GitHub API (GitHub thread)
+    Enforce,        // Rule evaluation for the newly focused app (observer thread)
+    FleetUpload,    // One journal batch sent and acknowledged by the fleet service (fleet thread)
+    Count
+};
+
+// 🔢 Plain event counters, grouped by the thread that owns them
+enum class Counter : std::size_t {
+    ObserverWakeups, // Times the observer thread woke (notification or poll tick)
+    Switches,        // Focus changes recorded
+    AnalyzerWakeups, // Analyzer ticks
+    EventsDrained,   // Switch events consumed by the analyzer
+    IdlePauses,      // Times observation paused for idle / lock / sleep
+    FlushBatches,    // Non-empty batches written by the flush thread
+    EventsFlushed,   // Switch events written to the journal
+    DayRotations,    // Day files opened by the flush thread
+    GitHubPolls,     // Requests sent by the GitHub thread
+    GitHubUnchanged, // ...of which answered 304 (free against rate limits)
+    RuleBlocks,      // Apps hidden by an enforcement rule
+    RuleWarnings,    // Enforcement warnings shown
+    FleetBatches,    // Journal batches acknowledged by the fleet service
+    FleetBytes,      // Frame bytes those batches took on the wire
+    Count
+};
+
+// 🌡️ Last-value gauges (written by one thread, read by dump())
+enum class Gauge : std::size_t {
+    PollIntervalMs,  // Current adaptive polling interval (polling mode)
+    PollsPerHour,    // Effective sampling rate at that interval
+    ArenaSpillBytes, // Analyzer day-arena bytes that overflowed its block onto the heap (0 in a normal day)
+    Count
+};
+
+inline const char* probeName(Probe probe) {
+    static constexpr const char* names[] = {"frontmost_app", "session_handoff", "flush_batch", "flush_sync",
+                                            "tab_query", "analyzer_drain", "analyze", "checkpoint",
+                                            "github_poll", "enforce", "fleet_upload"};
+    return names[static_cast<std::size_t>(probe)];
+}
+
+inline const char* gaugeName(Gauge gauge) {
+    static constexpr const char* names[] = {"poll_interval_ms", "polls_per_hour", "arena_spill_bytes"};
+    return names[static_cast<std::size_t>(gauge)];
+}
+
+inline const char* counterName(Counter counter) {
+    static constexpr const char* names[] = {"observer_wakeups", "switches", "analyzer_wakeups", "events_drained",
+                                            "idle_pauses", "flush_batches", "events_flushed", "day_rotations",
+                                            "github_polls", "github_unchanged", "rule_blocks", "rule_warnings",
+                                            "fleet_batches", "fleet_bytes"};
+    return names[static_cast<std::size_t>(counter)];
+}
+
+// 📏 Log2-scaled latency histogram: bucket i counts samples in [2^i, 2^(i+1)) nanoseconds
+class LatencyHistogram {
+public:
+    static constexpr int kBuckets = 40; // Up to ~9 minutes: anything longer saturates
+
+    void record(std::uint64_t nanos) {
+        const int bucket = nanos == 0 ? 0 : static_cast<int>(std::bit_width(nanos)) - 1;
+        buckets[bucket < kBuckets ? bucket : kBuckets - 1].fetch_add(1, std::memory_order_relaxed);
+        samples.fetch_add(1, std::memory_order_relaxed);
+        totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+        if (nanos > maxNanos.load(std::memory_order_relaxed)) maxNanos.store(nanos, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count() const { return samples.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return maxNanos.load(std::memory_order_relaxed); }
+    std::uint64_t mean() const {
+        const std::uint64_t n = count();
+        return n ? totalNanos.load(std::memory_order_relaxed) / n : 0;
+    }
+
+    // 🎯 Upper bound (ns) of the bucket holding the `fraction` quantile
+    std::uint64_t percentile(double fraction) const {
+        const std::uint64_t n = count();
+        if (n == 0) return 0;
+        const auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(n - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return (std::uint64_t(2) << i) - 1;
+        }
+        return max();
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets{};
+    std::atomic<std::uint64_t> samples{0};
+    std::atomic<std::uint64_t> totalNanos{0};
+    std::atomic<std::uint64_t> maxNanos{0};
+};
+
+// 📡 Process-wide instrumentation surface
+//    - Disabled (the default), a probe costs one relaxed load and a branch: no clock reads
+//    - Each probe/counter is written by one thread only, so updates never contend; dump() may run anywhere
+class Instrumentation {
+public:
+    void enable(bool on = true) { active.store(on, std::memory_order_relaxed); }
+    bool enabled() const { return active.load(std::memory_order_relaxed); }
+
+    void count(Counter counter, std::uint64_t n = 1) {
+        if (enabled()) counters[static_cast<std::size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void set(Gauge gauge, std::uint64_t value) {
+        if (enabled()) gauges[static_cast<std::size_t>(gauge)].store(value, std::memory_order_relaxed);
+    }
+
+    void record(Probe probe, std::uint64_t nanos) { histograms[static_cast<std::size_t>(probe)].record(nanos); }
+
+    const LatencyHistogram& histogram(Probe probe) const { return histograms[static_cast<std::size_t>(probe)]; }
+    std::uint64_t value(Counter counter) const {
+        return counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+    }
+
+    // ⏱ RAII timer for one probe; free when instrumentation is off
+    class Scope {
+    public:
+        Scope(Instrumentation& owner, Probe probe)
+            : owner(owner.enabled() ? &owner : nullptr), probe(probe),
+              started(this->owner ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()) {}
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope() {
+            if (!owner) return;
+            auto elapsed = std::chrono::steady_clock::now() - started;
+            owner->record(probe, static_cast<std::uint64_t>(
+                                     std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+    private:
+        Instrumentation* owner;
+        Probe probe;
+        std::chrono::steady_clock::time_point started;
+    };
+
+    Scope time(Probe probe) { return Scope(*this, probe); }
+
+    // 🖨 Machine-readable dump, one metric per line: "lunr.<kind>.<name> key=value ..."
+    void dump(std::ostream& out) const {
+        for (std::size_t c = 0; c < counters.size(); ++c) {
+            out << "lunr.counter." << counterName(static_cast<Counter>(c)) << " value=" << value(static_cast<Counter>(c))
+                << "\n";
+        }
+        for (std::size_t g = 0; g < gauges.size(); ++g) {
+            out << "lunr.gauge." << gaugeName(static_cast<Gauge>(g)) << " value="
+                << gauges[g].load(std::memory_order_relaxed) << "\n";
+        }
+        for (std::size_t p = 0; p < histograms.size(); ++p) {
+            const LatencyHistogram& h = histograms[p];
+            out << "lunr.latency." << probeName(static_cast<Probe>(p)) << " count=" << h.count()
+                << " mean_ns=" << h.mean() << " p50_ns=" << h.percentile(0.5) << " p99_ns=" << h.percentile(0.99)
+                << " max_ns=" << h.max() << "\n";
+        }
+    }
+
+private:
+    std::atomic<bool> active{false};
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::Count)> counters{};
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Gauge::Count)> gauges{};
+    std::array<LatencyHistogram, static_cast<std::size_t>(Probe::Count)> histograms{};
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <array>        // Fixed output buffer
+#include <cerrno>       // For EINTR
+#include <charconv>     // For std::to_chars (locale-free, allocation-free numbers)
+#include <cmath>        // For std::isfinite
+#include <concepts>     // For std::integral / std::same_as
+#include <cstdint>      // For the nesting bitmask
+#include <cstring>      // For std::memcpy
+#include <string_view>  // Keys and string values are borrowed, never copied
+#include <utility>      // For std::forward
+
+// 🐧 POSIX output
+#include <unistd.h>
+
+// 🧾 Streaming JSON writer: values go straight into a fixed buffer that is written to `fd` whenever it fills
+//    - No DOM, no std::string, no heap: export cost is the cost of the bytes
+//    - Compact output (no whitespace) to keep day files small
+//    - Commas are tracked with one bit per nesting level, so callers just emit keys and values in order
+class JsonWriter {
+public:
+    static constexpr std::size_t kBufferSize = 16 * 1024;
+    static constexpr int kMaxDepth = 64;
+
+    explicit JsonWriter(int outputFd) : fd(outputFd) {}
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+    ~JsonWriter() { flush(); }
+
+    JsonWriter& beginObject() { return open('{'); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray() { return open('['); }
+    JsonWriter& endArray() { return close(']'); }
+
+    // 🔑 Object key; the next call writes its value
+    JsonWriter& key(std::string_view name) {
+        separate();
+        quoted(name);
+        put(':');
+        afterKey = true;
+        return *this;
+    }
+
+    JsonWriter& value(std::string_view text) {
+        separate();
+        quoted(text);
+        return *this;
+    }
+
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+
+    template <std::integral Int>
+        requires(!std::same_as<Int, bool>)
+    JsonWriter& value(Int number) {
+        separate();
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        put(digits, static_cast<std::size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    // 🔢 Fixed-point double (non-finite values become null, which JSON requires)
+    JsonWriter& value(double number, int precision = 3) {
+        separate();
+        if (!std::isfinite(number)) {
+            put("null", 4);
+            return *this;
+        }
+        char digits[352]; // Enough for any finite double in fixed notation
+        auto result = std::to_chars(digits, digits + sizeof(digits), number, std::chars_format::fixed, precision);
+        put(digits, static_cast<std::size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    JsonWriter& value(bool flag) {
+        separate();
+        flag ? put("true", 4) : put("false", 5);
+        return *this;
+    }
+
+    // ➕ key + value in one call
+    template <typename T>
+    JsonWriter& field(std::string_view name, T&& v) {
+        key(name);
+        return value(std::forward<T>(v));
+    }
+
+    // 💾 Writes the buffered bytes; returns false once any write has failed
+    bool flush() {
+        std::size_t written = 0;
+        while (written < used && ok) {
+            ssize_t n = ::write(fd, buffer.data() + written, used - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) ok = false;
+            else written += static_cast<std::size_t>(n);
+        }
+        used = 0;
+        return ok;
+    }
+
+    bool good() const { return ok && depth == 0; }
+
+private:
+    JsonWriter& open(char bracket) {
+        separate();
+        put(bracket);
+        ++depth;
+        if (depth < kMaxDepth) hasItems &= ~(std::uint64_t{1} << depth);
+        return *this;
+    }
+
+    JsonWriter& close(char bracket) {
+        put(bracket);
+        --depth;
+        return *this;
+    }
+
+    // , before every item except the first in its container (and never between a key and its value)
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        if (depth == 0 || depth >= kMaxDepth) return;
+        const std::uint64_t bit = std::uint64_t{1} << depth;
+        if (hasItems & bit) put(',');
+        hasItems |= bit;
+    }
+
+    void quoted(std::string_view text) {
+        static constexpr char kHex[] = "0123456789abcdef";
+        put('"');
+        std::size_t run = 0; // Start of the pending run of bytes that need no escaping
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue; // UTF-8 passes through unchanged
+
+            put(text.data() + run, i - run);
+            run = i + 1;
+            if (c == '"' || c == '\\') {
+                const char escaped[2] = {'\\', static_cast<char>(c)};
+                put(escaped, 2);
+            } else {
+                const char escaped[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                put(escaped, 6);
+            }
+        }
+        put(text.data() + run, text.size() - run);
+        put('"');
+    }
+
+    void put(char c) {
+        if (used == buffer.size()) flush();
+        buffer[used++] = c;
+    }
+
+    void put(const char* data, std::size_t size) {
+        while (size > 0) {
+            if (used == buffer.size()) flush();
+            const std::size_t chunk = size < buffer.size() - used ? size : buffer.size() - used;
+            std::memcpy(buffer.data() + used, data, chunk);
+            used += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+    }
+
+    int fd;
+    bool ok = true;
+    bool afterKey = false;
+    int depth = 0;
+    std::uint64_t hasItems = 0; // Bit d set once the container at depth d has an item
+    std::size_t used = 0;
+    std::array<char, kBufferSize> buffer;
+};
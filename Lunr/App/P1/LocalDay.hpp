@@ -0,0 +1,32 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <ctime> // Local calendar conversion
+
+// 📅 The local calendar day containing some instant: its [begin, end) epoch bounds and "YYYY-MM-DD" name.
+//    Computed once per day so per-event checks are two integer compares (DST-length days included)
+struct LocalDay {
+    std::time_t begin = 0;
+    std::time_t end = 0; // Exclusive: the next local midnight
+    char date[11] = {};
+
+    bool contains(std::time_t t) const { return t >= begin && t < end; }
+};
+
+inline LocalDay localDayOf(std::time_t t) {
+    std::tm local{};
+    localtime_r(&t, &local);
+
+    LocalDay day;
+    std::strftime(day.date, sizeof(day.date), "%Y-%m-%d", &local);
+
+    local.tm_hour = 0;
+    local.tm_min = 0;
+    local.tm_sec = 0;
+    local.tm_isdst = -1; // Let mktime resolve DST for the day's midnight
+    day.begin = std::mktime(&local);
+    local.tm_mday += 1;
+    local.tm_isdst = -1;
+    day.end = std::mktime(&local);
+    return day;
+}
@@ -0,0 +1,353 @@
+// ⏱ Lunr benchmarks: replays synthetic switch streams through the agent's session, report, log and history code
+//    Build: clang++ -std=c++20 -O2 LunrBench.cpp -o LunrBench
+//    Usage: ./LunrBench [filter] [repeat]      (filter: substring of a benchmark name; repeat: runs per case)
+//
+//    Output is one line per case in the same "lunr.<kind>.<name> key=value ..." form as the metrics dump, e.g.
+//      lunr.bench.switch_replay apps=100 sessions_per_app=100 mean_session_sec=60 memory=heap ops=10000 ...
+//    so runs from two commits can be diffed or loaded into a spreadsheet as-is. Inputs are seeded and start at a
+//    fixed date with local time pinned to UTC: every run of a case sees the same stream, including where its
+//    hour and day boundaries fall.
+
+// 🧱 Standard C++ libraries
+#include <algorithm>  // For std::sort / std::min
+#include <chrono>     // For timing
+#include <cstdint>    // For counters
+#include <cstdlib>    // For std::atoi
+#include <ctime>      // Synthetic dates
+#include <filesystem> // Scratch directory for log and journal volumes
+#include <iomanip>    // Fixed-point results
+#include <iostream>   // For the result lines
+#include <memory>     // The ring lives on the heap (64 KiB)
+#include <random>     // Seeded synthetic streams
+#include <string>     // Names and paths
+#include <vector>     // Event streams and samples
+
+// 🐧 POSIX (scratch directory per process, /dev/null sink)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "AppRegistry.hpp"        // Synthetic app names
+#include "CategoryClassifier.hpp" // Observer-side category lookup
+#include "DayArena.hpp"           // Analyzer session table memory
+#include "EnforcementEngine.hpp"  // Observer-side rule evaluation
+#include "EventRing.hpp"          // Observer → analyzer handoff
+#include "FleetAggregator.hpp"    // Fleet service merge pool
+#include "FleetProtocol.hpp"      // Batch encoding
+#include "HistoryReader.hpp"      // Day / month / year reads
+#include "ReportWriter.hpp"       // Report sink
+#include "SessionAnalysis.hpp"    // Session update, snapshot, summary, daily log
+#include "SessionJournal.hpp"     // Journal volumes for the reader
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+// 📏 Timing of one case: best and median over `repeat` runs
+struct Result {
+    double bestNsPerOp = 0.0;
+    double medianNsPerOp = 0.0;
+    double totalMs = 0.0; // Median run
+};
+
+template <typename Fn>
+Result measure(int repeat, std::uint64_t ops, Fn&& run) {
+    std::vector<double> samples;
+    for (int r = 0; r < repeat; ++r) {
+        const auto started = BenchClock::now();
+        run();
+        samples.push_back(std::chrono::duration<double, std::nano>(BenchClock::now() - started).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    const double median = samples[samples.size() / 2];
+    const double perOp = ops > 0 ? static_cast<double>(ops) : 1.0;
+    return {samples.front() / perOp, median / perOp, median / 1.0e6};
+}
+
+// 🖨 "lunr.bench.<name> <params> ops=N best_ns_per_op=X median_ns_per_op=X median_ms=X"
+void report(const std::string& name, const std::string& params, std::uint64_t ops, const Result& result) {
+    std::cout << std::fixed << std::setprecision(3) << "lunr.bench." << name << " " << params
+              << (params.empty() ? "" : " ") << "ops=" << ops
+              << " best_ns_per_op=" << result.bestNsPerOp << " median_ns_per_op=" << result.medianNsPerOp
+              << " median_ms=" << result.totalMs << "\n";
+}
+
+// 🎲 Synthetic day: `apps` apps with Zipf-like popularity, exponential session lengths around `meanSessionSec`
+struct Stream {
+    AppRegistry registry;
+    std::vector<UsageCategory> categoryOf; // Indexed by AppId
+    std::vector<SwitchEvent> events;
+};
+
+constexpr std::int64_t kStreamStartEpoch = 1704067200; // 2024-01-01 00:00 UTC (a Monday)
+
+void makeStream(Stream& stream, std::size_t apps, std::size_t sessionsPerApp, double meanSessionSec) {
+    std::mt19937_64 random(0x4c554e52); // "LUNR": identical streams across runs and commits
+    std::vector<AppId> ids;
+    for (std::size_t i = 0; i < apps; ++i) {
+        const std::string key = "com.bench.app" + std::to_string(i);
+        ids.push_back(stream.registry.intern(key, "App " + std::to_string(i)));
+    }
+    stream.categoryOf.assign(apps + 1, UsageCategory::Other);
+    for (std::size_t i = 0; i < apps; ++i) {
+        stream.categoryOf[ids[i]] = static_cast<UsageCategory>(i % kCategoryCount);
+    }
+
+    std::vector<double> weights;
+    for (std::size_t i = 0; i < apps; ++i) weights.push_back(1.0 / static_cast<double>(i + 1));
+    std::discrete_distribution<std::size_t> pick(weights.begin(), weights.end());
+    std::exponential_distribution<double> length(1.0 / meanSessionSec);
+
+    const std::size_t total = apps * sessionsPerApp;
+    stream.events.clear();
+    stream.events.reserve(total);
+    Clock::time_point at{Seconds(kStreamStartEpoch)}; // Not now(): baseline folds and day rotations would move
+    for (std::size_t i = 0; i < total; ++i) {
+        const AppId app = ids[pick(random)];
+        const Seconds duration(1 + static_cast<long long>(length(random)));
+        stream.events.push_back(SwitchEvent{app, stream.categoryOf[app], at, duration});
+        at += duration;
+    }
+}
+
+// 🔀 Analyzer path: applySwitchEvent over a whole stream, with the session table on the heap or (as in the
+//    agent) in a DayArena released after each day
+void benchSwitchReplay(const std::string& filter, int repeat) {
+    if (std::string("switch_replay").find(filter) == std::string::npos) return;
+    DayArena arena;
+    for (std::size_t apps : {10, 100, 1000}) {
+        for (std::size_t sessionsPerApp : {10, 100, 1000}) {
+            for (double meanSessionSec : {5.0, 60.0, 600.0}) {
+                Stream stream;
+                makeStream(stream, apps, sessionsPerApp, meanSessionSec);
+                for (bool pooled : {false, true}) {
+                    const Result result = measure(repeat, stream.events.size(), [&] {
+                        {
+                            AnalyzerState state(pooled ? arena.resource() : std::pmr::get_default_resource());
+                            for (const SwitchEvent& event : stream.events) applySwitchEvent(state, event);
+                        }
+                        arena.release();
+                    });
+                    report("switch_replay",
+                           "apps=" + std::to_string(apps) + " sessions_per_app=" + std::to_string(sessionsPerApp) +
+                               " mean_session_sec=" + std::to_string(static_cast<int>(meanSessionSec)) +
+                               " memory=" + (pooled ? "arena" : "heap"),
+                           stream.events.size(), result);
+                }
+            }
+        }
+    }
+}
+
+// 🤝 Observer path: category lookup, rule evaluation and the ring handoff per switch
+void benchObserverHandoff(const std::string& filter, int repeat) {
+    if (std::string("observer_handoff").find(filter) == std::string::npos) return;
+    for (std::size_t apps : {10, 100, 1000}) {
+        Stream stream;
+        makeStream(stream, apps, 100, 60.0);
+
+        CategoryClassifier classifier;
+        EnforcementEngine enforcement;
+        enforcement.addRule("Entertainment", "block after 2h");
+        enforcement.addRule("Social", "warn after 30m");
+        enforcement.addRule("App 3", "block during 09:00-17:00 weekdays");
+        enforcement.compile();
+        for (AppId id = 1; id <= apps; ++id) {
+            classifier.assign(id, stream.registry.keyOf(id), stream.registry.nameOf(id));
+            enforcement.bindApp(id, stream.registry.keyOf(id), stream.registry.nameOf(id));
+        }
+
+        auto ring = std::make_unique<EventRing<SwitchEvent, 4096>>();
+        std::uint64_t blocked = 0;
+        const Result result = measure(repeat, stream.events.size(), [&] {
+            const EnforcementContext context{1, 2, 600, 0, 0};
+            for (const SwitchEvent& event : stream.events) {
+                const UsageCategory category = classifier.categoryOf(event.app);
+                enforcement.credit(event.app, category, static_cast<std::uint32_t>(event.duration.count()), 1);
+                blocked += enforcement.evaluate(event.app, category, context).action == RuleAction::Block;
+                if (!ring->tryPush(event)) ring->drain([](const SwitchEvent&) {}); // Stand-in for the analyzer
+            }
+            ring->drain([](const SwitchEvent&) {});
+        });
+        report("observer_handoff", "apps=" + std::to_string(apps) + " rules=" + std::to_string(enforcement.size()),
+               stream.events.size(), result);
+        if (blocked == 0) std::cerr << "⚠️ observer_handoff: no rule ever fired\n"; // Keeps the loop observable
+    }
+}
+
+// 🧠 Report path: behavior snapshot and exit summary, formatted into a buffer and written to /dev/null
+void benchReports(const std::string& filter, int repeat) {
+    const bool snapshot = std::string("analyze_behavior").find(filter) != std::string::npos;
+    const bool summary = std::string("print_summary").find(filter) != std::string::npos;
+    if (!snapshot && !summary) return;
+
+    const int sink = ::open("/dev/null", O_WRONLY);
+    for (std::size_t apps : {10, 100, 1000}) {
+        Stream stream;
+        makeStream(stream, apps, 100, 60.0);
+        AnalyzerState state;
+        CategoryCounters::Snapshot categories{};
+        for (const SwitchEvent& event : stream.events) {
+            applySwitchEvent(state, event);
+            categories[static_cast<std::size_t>(event.category)] += static_cast<std::uint64_t>(event.duration.count());
+        }
+
+        ReportWriter out(sink);
+        const Clock::time_point now = stream.events.back().startTime + stream.events.back().duration;
+        constexpr std::uint64_t kReports = 1000;
+        if (snapshot) {
+            const Result result = measure(repeat, kReports, [&] {
+                for (std::uint64_t i = 0; i < kReports; ++i) {
+                    writeBehaviorSnapshot(state, stream.registry, categories, PipelineHealth{}, now, out);
+                }
+            });
+            report("analyze_behavior", "apps=" + std::to_string(apps), kReports, result);
+        }
+        if (summary) {
+            const Result result = measure(repeat, 100, [&] {
+                for (int i = 0; i < 100; ++i) writeUsageSummary(state.sessions, stream.registry, out);
+            });
+            report("print_summary", "apps=" + std::to_string(apps), 100, result);
+        }
+    }
+    ::close(sink);
+}
+
+// 📆 One synthetic day per date, written as a journal (or a legacy text log) into `directory`
+std::vector<std::string> writeVolume(const std::filesystem::path& directory, int days, bool legacy,
+                                     const Stream& day) {
+    std::vector<std::string> dates;
+    std::tm local{};
+    local.tm_year = 2025 - 1900;
+    local.tm_mday = 1;
+    local.tm_hour = 12;
+    local.tm_isdst = -1;
+    for (int d = 0; d < days; ++d) {
+        std::tm date = local;
+        date.tm_mday += d;
+        std::mktime(&date); // Normalizes day overflow into the following months
+        char name[16];
+        std::strftime(name, sizeof(name), "%Y-%m-%d", &date);
+        dates.push_back(name);
+
+        if (legacy) {
+            AnalyzerState state;
+            for (const SwitchEvent& event : day.events) applySwitchEvent(state, event);
+            writeDailyLogFile((directory / ("lunr_log_" + dates.back() + ".log")).string(), dates.back(),
+                              state.sessions, day.registry);
+        } else {
+            SessionJournal journal;
+            if (!journal.open((directory / ("lunr_journal_" + dates.back() + ".bin")).string())) continue;
+            for (const SwitchEvent& event : day.events) journal.add(event, day.registry);
+            journal.flush();
+        }
+    }
+    return dates;
+}
+
+// 📚 Log path: writeDailyLog, then the history reader over a day, a month and a year of files
+void benchLogs(const std::string& filter, int repeat, const std::filesystem::path& scratch) {
+    const bool writer = std::string("write_daily_log").find(filter) != std::string::npos;
+    const bool reader = std::string("history_read").find(filter) != std::string::npos;
+    if (!writer && !reader) return;
+
+    Stream day;
+    makeStream(day, 100, 20, 60.0); // ~2000 switches: a heavy day
+
+    if (writer) {
+        AnalyzerState state;
+        for (const SwitchEvent& event : day.events) applySwitchEvent(state, event);
+        const std::string path = (scratch / "lunr_log_bench.log").string();
+        const Result result = measure(repeat, 100, [&] {
+            for (int i = 0; i < 100; ++i) writeDailyLogFile(path, "2025-01-01", state.sessions, day.registry);
+        });
+        report("write_daily_log", "apps=100", 100, result);
+    }
+
+    if (!reader) return;
+    for (bool legacy : {false, true}) {
+        for (int days : {1, 30, 365}) {
+            const std::filesystem::path directory =
+                scratch / ((legacy ? "legacy_" : "journal_") + std::to_string(days));
+            std::filesystem::create_directories(directory);
+            const std::vector<std::string> dates = writeVolume(directory, days, legacy, day);
+            const std::string& from = dates.front();
+            const std::string& to = dates.back();
+
+            std::uint64_t sessions = 0;
+            std::size_t apps = 0;
+            const Result result = measure(repeat, 1, [&] {
+                HistoryReader history;
+                history.openDirectory(directory.string());
+                apps = history.topApps(from, to, 10).size();
+                sessions = history.aggregate(from, to).stats.totalSwitches;
+            });
+            report("history_read",
+                   std::string("format=") + (legacy ? "legacy" : "journal") + " days=" + std::to_string(days) +
+                       " sessions=" + std::to_string(sessions) + " top_apps=" + std::to_string(apps),
+                   1, result);
+        }
+    }
+}
+
+// 🛰️ Fleet service path: batch decode + per-user / per-team merge for `agents` agents' days across the pool
+void benchFleetMerge(const std::string& filter, int repeat) {
+    if (std::string("fleet_merge").find(filter) == std::string::npos) return;
+    Stream stream;
+    makeStream(stream, 100, 100, 60.0); // One agent-day: 10,000 sessions
+
+    // Encode the day once, the way the uploader ships it
+    fleet::BatchEncoder encoder;
+    encoder.begin();
+    std::vector<bool> named(stream.registry.size(), false);
+    for (const SwitchEvent& event : stream.events) {
+        if (!named[event.app]) {
+            encoder.name(event.app, stream.registry.nameOf(event.app));
+            named[event.app] = true;
+        }
+        encoder.record(journal::JournalRecord{event.app, static_cast<std::uint32_t>(event.duration.count()),
+                                              Clock::to_time_t(event.startTime)});
+    }
+    const std::vector<unsigned char> payload = encoder.finish("2025-01-01", 0, stream.events.size() * 16);
+
+    CategoryClassifier classifier;
+    for (std::size_t agents : {16, 256}) {
+        for (unsigned workers : {1u, 2u, 4u}) {
+            const Result result = measure(repeat, agents * stream.events.size(), [&] {
+                FleetAggregator aggregator(classifier, workers);
+                aggregator.start();
+                for (std::size_t a = 0; a < agents; ++a) {
+                    const std::string user = "user" + std::to_string(a);
+                    aggregator.submit(fleet::Identity{user, user, "team" + std::to_string(a % 8)}, payload);
+                }
+                aggregator.stop(); // Drains every queue
+            });
+            report("fleet_merge",
+                   "agents=" + std::to_string(agents) + " workers=" + std::to_string(workers) +
+                       " batch_bytes=" + std::to_string(payload.size()),
+                   agents * stream.events.size(), result);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string filter = argc > 1 ? argv[1] : "";
+    const int repeat = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+    ::setenv("TZ", "UTC", 1); // Local hours and days fall the same way on every machine
+    ::tzset();
+
+    const std::filesystem::path scratch =
+        std::filesystem::temp_directory_path() / ("lunr_bench_" + std::to_string(::getpid()));
+    std::filesystem::create_directories(scratch);
+
+    benchObserverHandoff(filter, repeat);
+    benchSwitchReplay(filter, repeat);
+    benchReports(filter, repeat);
+    benchLogs(filter, repeat, scratch);
+    benchFleetMerge(filter, repeat);
+
+    std::error_code ignored;
+    std::filesystem::remove_all(scratch, ignored);
+    return 0;
+}
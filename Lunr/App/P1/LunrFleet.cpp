@@ -0,0 +1,318 @@
+// 🛰️ Lunr fleet service: accepts journal batches from many agents over persistent connections and merges
+//    them into per-user and per-team rollups on a worker pool
+//    Build: clang++ -std=c++20 -O2 LunrFleet.cpp -o LunrFleet
+//    Usage: ./LunrFleet [--port N] [--workers N] [--report-every S] [--categories file]
+//      --port N          TCP port to listen on (default 7419)
+//      --workers N       merge threads (default: one per core)
+//      --report-every S  print the team / user rollups every S seconds (default 60, 0 = only at exit)
+//    Agents connect with: SystemObserver --fleet <host[:port]> --fleet-user <name> --fleet-team <name>
+//    Enter (or SIGINT / SIGTERM when running detached) stops the service after merging every batch it acked
+
+// 🧱 Standard C++ libraries
+#include <algorithm>          // For std::remove_if
+#include <atomic>             // Connection counters read by the reporter
+#include <cerrno>             // For EAGAIN / EINTR
+#include <chrono>             // Report interval
+#include <condition_variable> // For the reporter's stop-aware wait
+#include <cstdint>            // Offsets and counters
+#include <cstdlib>            // For std::atoi
+#include <iostream>           // For console I/O
+#include <mutex>              // Paired with the condition variable
+#include <stop_token>         // For immediate shutdown
+#include <string>             // Arguments and de-duplication keys
+#include <thread>             // For std::jthread
+#include <unordered_map>      // Agent day → high-water offset
+#include <utility>            // For std::move
+#include <vector>             // Connections and buffers
+
+// 🐧 POSIX sockets and signals
+#include <csignal>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "CategoryClassifier.hpp" // Service-side categories
+#include "FleetAggregator.hpp"    // Merge pool and rollups
+#include "FleetProtocol.hpp"      // Frames
+#include "ReportWriter.hpp"       // Rollup reports
+
+// 🔌 The network side: one poll() loop multiplexes every agent connection on a single thread
+//    - Frames are parsed from per-connection buffers; Batch payloads are copied out once and handed to the
+//      merge pool, so the loop never decodes or merges
+//    - De-duplication happens here, before the Ack: a Batch whose slice starts below the agent's high-water
+//      offset for that day was (at least partly) merged already and is answered with that offset instead
+class FleetServer {
+public:
+    explicit FleetServer(FleetAggregator& pool) : aggregator(pool) {}
+    ~FleetServer() {
+        for (Connection& connection : connections) ::close(connection.fd);
+        if (listener >= 0) ::close(listener);
+    }
+
+    // 📡 Binds every interface on `port` (IPv6 dual-stack where available)
+    bool listen(std::uint16_t port) {
+        const int one = 1;
+        listener = ::socket(AF_INET6, SOCK_STREAM, 0);
+        if (listener >= 0) {
+            const int zero = 0;
+            ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            ::setsockopt(listener, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));
+            sockaddr_in6 address{};
+            address.sin6_family = AF_INET6;
+            address.sin6_port = htons(port);
+            address.sin6_addr = in6addr_any;
+            if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) return finishListen();
+            ::close(listener);
+        }
+        listener = ::socket(AF_INET, SOCK_STREAM, 0); // No IPv6: plain IPv4
+        if (listener < 0) return false;
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) return finishListen();
+        ::close(listener);
+        listener = -1;
+        return false;
+    }
+
+    // 🔁 Serves until `stop` is requested (polls in half-second slices so a stop is noticed promptly)
+    void run(std::stop_token stop) {
+        std::vector<pollfd> polled;
+        while (!stop.stop_requested()) {
+            polled.clear();
+            polled.push_back(pollfd{listener, POLLIN, 0});
+            for (const Connection& connection : connections) {
+                const short events = connection.out.empty() ? POLLIN : static_cast<short>(POLLIN | POLLOUT);
+                polled.push_back(pollfd{connection.fd, events, 0});
+            }
+            if (::poll(polled.data(), polled.size(), 500) <= 0) continue;
+
+            // Existing connections first: their indices line up with polled[1..]
+            for (std::size_t i = 0; i < connections.size(); ++i) {
+                const short revents = polled[i + 1].revents;
+                Connection& connection = connections[i];
+                if (revents & (POLLIN | POLLHUP | POLLERR)) receive(connection);
+                if ((revents & POLLOUT) && !connection.closed) transmit(connection);
+            }
+            connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                             [](const Connection& connection) {
+                                                 if (connection.closed) ::close(connection.fd);
+                                                 return connection.closed;
+                                             }),
+                              connections.end());
+            open.store(connections.size(), std::memory_order_relaxed);
+            if (polled[0].revents & POLLIN) accept();
+        }
+    }
+
+    std::size_t connected() const { return open.load(std::memory_order_relaxed); }
+    std::uint64_t duplicates() const { return duplicateBatches.load(std::memory_order_relaxed); }
+    std::uint64_t refused() const { return refusedBatches.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kReadChunk = 64 * 1024;
+
+    struct Connection {
+        int fd = -1;
+        bool closed = false;
+        bool greeted = false; // Hello received
+        fleet::Identity identity;
+        std::vector<unsigned char> in;  // Bytes received, not yet parsed into frames
+        std::vector<unsigned char> out; // Acks not yet sent (a slow reader never blocks the loop)
+    };
+
+    bool finishListen() {
+        if (::listen(listener, SOMAXCONN) != 0) return false;
+        ::fcntl(listener, F_SETFL, ::fcntl(listener, F_GETFL, 0) | O_NONBLOCK);
+        return true;
+    }
+
+    void accept() {
+        for (;;) {
+            const int fd = ::accept(listener, nullptr, nullptr);
+            if (fd < 0) return; // EAGAIN: backlog drained
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            const int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+            ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+            Connection connection;
+            connection.fd = fd;
+            connections.push_back(std::move(connection));
+            open.store(connections.size(), std::memory_order_relaxed);
+        }
+    }
+
+    void receive(Connection& connection) {
+        for (;;) {
+            const std::size_t used = connection.in.size();
+            connection.in.resize(used + kReadChunk);
+            const ssize_t n = ::recv(connection.fd, connection.in.data() + used, kReadChunk, 0);
+            connection.in.resize(used + static_cast<std::size_t>(n > 0 ? n : 0));
+            if (n > 0) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) break;
+            connection.closed = true; // Orderly close or error
+            return;
+        }
+
+        // Consume every complete frame; a partial one stays buffered for the next read
+        std::size_t at = 0;
+        while (!connection.closed && connection.in.size() - at >= sizeof(fleet::FrameHeader)) {
+            fleet::FrameHeader header{};
+            if (!fleet::readHeader(connection.in.data() + at, header)) {
+                connection.closed = true; // Not a Lunr agent, or a version we do not speak
+                break;
+            }
+            const std::size_t frameSize = sizeof(header) + header.payloadBytes;
+            if (connection.in.size() - at < frameSize) break;
+            handle(connection, header, connection.in.data() + at + sizeof(header));
+            at += frameSize;
+        }
+        connection.in.erase(connection.in.begin(), connection.in.begin() + static_cast<std::ptrdiff_t>(at));
+        if (!connection.out.empty() && !connection.closed) transmit(connection);
+    }
+
+    void handle(Connection& connection, const fleet::FrameHeader& header, const unsigned char* payload) {
+        if (header.kind == static_cast<std::uint16_t>(fleet::FrameKind::Hello)) {
+            connection.greeted = fleet::decodeHello(payload, header.payloadBytes, connection.identity);
+            connection.closed = !connection.greeted;
+            return;
+        }
+        fleet::BatchInfo info;
+        if (header.kind != static_cast<std::uint16_t>(fleet::FrameKind::Batch) || !connection.greeted ||
+            !fleet::readBatchInfo(payload, header.payloadBytes, info)) {
+            connection.closed = true; // Protocol error
+            return;
+        }
+
+        std::uint64_t& highWater = highWaters[connection.identity.agent + '/' + std::string(info.date)];
+        if (info.fromOffset < highWater) {
+            duplicateBatches.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            std::vector<unsigned char> batch(payload, payload + header.payloadBytes); // The one copy: pool owns it
+            if (!aggregator.submit(connection.identity, std::move(batch))) {
+                refusedBatches.fetch_add(1, std::memory_order_relaxed);
+                connection.closed = true; // Saturated: the agent backs off and re-sends the slice later
+                return;
+            }
+            highWater = info.toOffset;
+        }
+        fleet::encodeAck(highWater, ackPayload);
+        fleet::appendFrame(connection.out, fleet::FrameKind::Ack, header.sequence, 0, ackPayload);
+    }
+
+    void transmit(Connection& connection) {
+        std::size_t sent = 0;
+        while (sent < connection.out.size()) {
+#ifdef MSG_NOSIGNAL
+            const ssize_t n = ::send(connection.fd, connection.out.data() + sent, connection.out.size() - sent,
+                                     MSG_NOSIGNAL);
+#else
+            const ssize_t n = ::send(connection.fd, connection.out.data() + sent, connection.out.size() - sent, 0);
+#endif
+            if (n > 0) {
+                sent += static_cast<std::size_t>(n);
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) break; // Rest on POLLOUT
+            connection.closed = true;
+            break;
+        }
+        connection.out.erase(connection.out.begin(), connection.out.begin() + static_cast<std::ptrdiff_t>(sent));
+    }
+
+    FleetAggregator& aggregator;
+    int listener = -1;
+    std::vector<Connection> connections;                      // Loop thread only
+    std::unordered_map<std::string, std::uint64_t> highWaters; // "agent/date" → bytes merged (loop thread only)
+    std::vector<unsigned char> ackPayload;                     // Reused per Ack
+    std::atomic<std::size_t> open{0};
+    std::atomic<std::uint64_t> duplicateBatches{0};
+    std::atomic<std::uint64_t> refusedBatches{0};
+};
+
+// 📋 Fleet-wide header plus every team and user rollup, in one write
+void printReport(const FleetAggregator& aggregator, const FleetServer& server, ReportWriter& out) {
+    const auto teams = aggregator.teams();
+    const auto users = aggregator.users();
+    out << "\n🛰️ [Fleet] " << server.connected() << " agents connected, " << users.size() << " users, "
+        << teams.size() << " teams\n";
+    out << " - Batches: " << aggregator.merged() << " merged (" << aggregator.sessions() << " sessions), "
+        << server.duplicates() << " duplicates, " << server.refused() << " refused, " << aggregator.malformed()
+        << " malformed\n";
+    writeFleetRollups("Team", teams, out);
+    writeFleetRollups("User", users, out);
+    out << "----------------------------------------\n";
+    out.flush();
+}
+
+int main(int argc, char* argv[]) {
+    // 🛑 Shutdown arrives as a signal either way: blocked in every thread and collected by sigwait() below
+    sigset_t shutdownSignals;
+    sigemptyset(&shutdownSignals);
+    sigaddset(&shutdownSignals, SIGINT);
+    sigaddset(&shutdownSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &shutdownSignals, nullptr); // Inherited by the threads started below
+
+    std::uint16_t port = fleet::kDefaultPort;
+    unsigned workers = 0;
+    int reportEvery = 60;
+    CategoryClassifier classifier;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+        if (arg == "--workers" && i + 1 < argc) workers = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        if (arg == "--report-every" && i + 1 < argc) reportEvery = std::max(0, std::atoi(argv[++i]));
+        if (arg == "--categories" && i + 1 < argc) classifier.loadRules(argv[++i]);
+    }
+
+    FleetAggregator aggregator(classifier, workers);
+    FleetServer server(aggregator);
+    if (!server.listen(port)) {
+        std::cout << "⚠️ Could not listen on port " << port << "\n";
+        return 1;
+    }
+    aggregator.start();
+    std::jthread network([&](std::stop_token stop) { server.run(stop); });
+
+    std::mutex reportMutex;
+    std::condition_variable_any reportWakeup;
+    std::jthread reporter([&](std::stop_token stop) {
+        if (reportEvery == 0) return;
+        ReportWriter out;
+        std::unique_lock<std::mutex> lock(reportMutex);
+        while (!reportWakeup.wait_for(lock, stop, std::chrono::seconds(reportEvery), [] { return false; }) &&
+               !stop.stop_requested()) {
+            printReport(aggregator, server, out);
+        }
+    });
+
+    std::cout << "🛰️ LunrFleet listening on port " << port << " with " << aggregator.workerCount()
+              << " merge workers (press Enter to stop)\n";
+
+    // ⌨️ Enter turns into SIGTERM; with no terminal (stdin at EOF) the watcher just ends
+    std::thread([] {
+        std::string line;
+        if (std::getline(std::cin, line)) ::kill(::getpid(), SIGTERM);
+    }).detach();
+    int received = 0;
+    sigwait(&shutdownSignals, &received);
+
+    // 🛑 Stop accepting, then merge everything acknowledged, then report
+    network.request_stop();
+    network.join();
+    reporter.request_stop();
+    reporter.join();
+    aggregator.stop();
+
+    ReportWriter out;
+    printReport(aggregator, server, out);
+    return 0;
+}
@@ -0,0 +1,117 @@
+// ⏩ Lunr replay: drives the observer core, analyzer and enforcement from recorded journals instead of AppKit,
+//    so the pipeline can be load-tested and profiled anywhere (Linux CI included)
+//    Build: clang++ -std=c++20 -O2 LunrReplay.cpp -o LunrReplay
+//    Usage: ./LunrReplay <journal-dir> [--speed N] [--loops N] [--rules file] [--categories file] [--metrics]
+//                                      [--alerts]
+//      --speed N   recorded seconds per wall-clock second (default 0: as fast as possible)
+//      --loops N   play the recording N times back to back (shifted by whole weeks) for million-event runs
+//      --alerts    print every block / warning line (off by default: a replay can fire thousands)
+
+// 🧱 Standard C++ libraries
+#include <algorithm> // For std::max
+#include <atomic>    // Contribution count the gate rules read
+#include <chrono>    // Wall-clock timing of the run
+#include <cstdlib>   // For std::atof / std::atoi
+#include <iostream>  // For console I/O
+#include <memory>    // Pipeline objects live on the heap (the ring and registry are large)
+#include <string>    // For arguments
+
+#include "AppRegistry.hpp"        // Replay-local intern table
+#include "CategoryClassifier.hpp" // App → category
+#include "CategoryCounters.hpp"   // Live per-category seconds
+#include "EnforcementEngine.hpp"  // Rules under test
+#include "EventRing.hpp"          // Observer → analyzer handoff
+#include "FocusObserver.hpp"      // Observer core (same code as the agent)
+#include "Instrumentation.hpp"    // Probes and counters
+#include "ReplaySource.hpp"       // Recorded journals as a focus source
+#include "ReportWriter.hpp"       // Final reports
+#include "SessionAnalysis.hpp"    // Analyzer state and reports
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0]
+                  << " <journal-dir> [--speed N] [--loops N] [--rules file] [--categories file] [--metrics]"
+                     " [--alerts]\n";
+        return 1;
+    }
+
+    double speed = 0.0;
+    std::size_t loops = 1;
+    bool alerts = false;
+    auto metrics = std::make_unique<Instrumentation>();
+    auto classifier = std::make_unique<CategoryClassifier>();
+    auto enforcement = std::make_unique<EnforcementEngine>();
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--speed" && i + 1 < argc) speed = std::atof(argv[++i]);
+        if (arg == "--loops" && i + 1 < argc) loops = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        if (arg == "--rules" && i + 1 < argc) enforcement->loadRules(argv[++i]);
+        if (arg == "--categories" && i + 1 < argc) classifier->loadRules(argv[++i]);
+        if (arg == "--metrics") metrics->enable();
+        if (arg == "--alerts") alerts = true;
+    }
+
+    auto registry = std::make_unique<AppRegistry>();
+    auto categoryUsage = std::make_unique<CategoryCounters>();
+    auto switchEvents = std::make_unique<EventRing<SwitchEvent, 1024>>();
+    std::atomic<std::uint32_t> contributionsToday{0};
+
+    // 📂 Journals store display names, which double as keys here (rules and categories match either)
+    ReplaySource source(speed, loops);
+    const std::size_t recorded = source.openDirectory(argv[1], [&](std::string_view name) {
+        const AppId id = registry->intern(name, name);
+        classifier->assign(id, name, name);
+        enforcement->bindApp(id, name, name);
+        return id;
+    });
+    if (recorded == 0) {
+        std::cout << "⚠️ No Lunr journals found in " << argv[1] << "\n";
+        return 1;
+    }
+
+    // No journal writer: a replay must never append to the journals it reads
+    FocusObserver focus(source, *switchEvents, nullptr, *classifier, *categoryUsage, *enforcement,
+                        contributionsToday, *metrics);
+    focus.setAlerts(alerts);
+
+    // 🧠 The analyzer runs inline after every step: deterministic, and the ring can never overflow
+    auto analysis = std::make_unique<AnalyzerState>();
+    auto drain = [&] {
+        metrics->count(Counter::EventsDrained,
+                       switchEvents->drain([&](const SwitchEvent& event) { applySwitchEvent(*analysis, event); }));
+    };
+
+    const auto started = std::chrono::steady_clock::now();
+    std::uint64_t steps = 0;
+
+    ReplaySource::Step step;
+    source.next(step);
+    ObserverState observer{step.app, step.at};
+    focus.enforceFocus(observer, step.at);
+    while (source.next(step)) {
+        ++steps;
+        // ⏰ A deadline that fell inside the previous session fires at its recorded instant
+        const Clock::time_point until = step.awaySince != Clock::time_point::max() ? step.awaySince : step.at;
+        if (observer.enforceAt <= until) focus.enforceFocus(observer, observer.enforceAt);
+        if (step.awaySince != Clock::time_point::max()) focus.markAway(observer, step.awaySince);
+        focus.recordSwitch(observer, step.app, step.at);
+        drain();
+    }
+    if (!observer.away) focus.closeCurrentSession(observer, source.lastEnd());
+    drain();
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    ReportWriter out;
+    writeBehaviorSnapshot(*analysis, *registry, categoryUsage->snapshot(), PipelineHealth{switchEvents->dropped(), 0},
+                          source.lastEnd(), out);
+    writeUsageSummary(analysis->sessions, *registry, out);
+    const double rate = static_cast<double>(steps + 1) / (elapsed > 0 ? elapsed : 1e-9);
+    out << "\n⏩ Replayed " << steps + 1 << " switches (" << recorded << " sessions × " << loops << ") in "
+        << Fixed{elapsed * 1000.0} << " ms, " << Fixed{rate, 0} << " switches/s\n";
+    out << " - Blocks: " << source.hidden() << ", Rules: " << enforcement->size() << "\n";
+    out.flush();
+
+    if (metrics->enabled()) metrics->dump(std::cout);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <cstddef> // For std::size_t
+#include <string>  // For file paths
+#include <utility> // For std::exchange
+
+// 🐧 POSIX memory mapping
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 🗺️ RAII read-only memory mapping of a whole file (move-only; unmapped on destruction)
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept
+        : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)) {}
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            base = std::exchange(other.base, nullptr);
+            length = std::exchange(other.length, 0);
+        }
+        return *this;
+    }
+    ~MappedFile() { unmap(); }
+
+    // 📂 Maps `path`; returns false if it cannot be opened or is empty
+    bool open(const std::string& path) {
+        unmap();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapped = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps its own reference to the file
+        if (mapped == MAP_FAILED) return false;
+
+        base = static_cast<const unsigned char*>(mapped);
+        length = static_cast<std::size_t>(info.st_size);
+        return true;
+    }
+
+    const unsigned char* data() const { return base; }
+    std::size_t size() const { return length; }
+    bool isOpen() const { return base != nullptr; }
+
+private:
+    void unmap() {
+        if (base) ::munmap(const_cast<unsigned char*>(base), length);
+        base = nullptr;
+        length = 0;
+    }
+
+    const unsigned char* base = nullptr;
+    std::size_t length = 0;
+};
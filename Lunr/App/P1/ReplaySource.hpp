@@ -0,0 +1,135 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>          // For std::sort / std::stable_sort
+#include <chrono>             // Recorded times and pacing
+#include <condition_variable> // For the stop-aware pacing wait
+#include <cstdint>            // Journal fields
+#include <filesystem>         // Journal directory
+#include <mutex>              // Paired with the condition variable
+#include <stop_token>         // For an immediate stop mid-wait
+#include <string>             // Paths and names
+#include <string_view>        // Recorded names borrowed from the mapping
+#include <vector>             // Flat record table
+
+#include "AppSession.hpp"     // Clock, Seconds
+#include "FocusSource.hpp"    // The interface this backend implements
+#include "MappedFile.hpp"     // Zero-copy journal reads
+#include "SessionJournal.hpp" // journal::walk
+
+// ⏩ Replay backend: recorded switch journals played back as focus changes, at any speed
+//    - Every lunr_journal_YYYY-MM-DD.bin in a directory is loaded (in date order) into one flat table
+//    - next() yields the switches in recorded order, with their recorded timestamps, and reports a gap in the
+//      recording (idle, lock, agent not running) as away time so the observer closes the session where it ended
+//    - speed 0 replays as fast as the pipeline can take it; speed N waits 1/N of each recorded gap
+//    - loops > 1 plays the recording again, shifted by whole weeks so weekday / hour rules still line up
+//    - Blocks cannot change the past: hideFrontmost() only counts them
+class ReplaySource : public FocusSource {
+public:
+    // ▶️ One recorded switch
+    struct Step {
+        AppId app = AppRegistry::kUnknown;
+        Clock::time_point at;                                   // When focus moved to `app`
+        Clock::time_point awaySince = Clock::time_point::max(); // Previous session's end, if the user was away
+    };
+
+    static constexpr std::int64_t kGapToleranceSec = 2; // Durations are whole seconds: smaller gaps are rounding
+
+    explicit ReplaySource(double speed = 0.0, std::size_t loops = 1)
+        : pace(speed), passes(std::max<std::size_t>(1, loops)) {}
+
+    // 📂 Loads every journal in `directory`; `intern(name)` returns this run's id for a recorded app name.
+    //    Returns the number of recorded sessions
+    template <typename Intern>
+    std::size_t openDirectory(const std::string& directory, Intern&& intern) {
+        std::vector<std::filesystem::path> files;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            const std::string name = entry.path().filename().string();
+            if (name.rfind("lunr_journal_", 0) == 0 && entry.path().extension() == ".bin") {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end()); // Date-stamped names sort chronologically
+
+        records.clear();
+        for (const auto& path : files) {
+            MappedFile file;
+            if (!file.open(path.string())) continue;
+            std::vector<AppId> local; // File-local id → this run's id (later entries override earlier ones)
+            journal::walk(
+                file.data(), file.size(),
+                [&](AppId id, std::string_view name) {
+                    if (id >= local.size()) local.resize(id + 1, AppRegistry::kUnknown);
+                    local[id] = intern(name);
+                },
+                [&](const journal::JournalRecord& record) {
+                    const AppId app = record.app < local.size() ? local[record.app] : AppRegistry::kUnknown;
+                    records.push_back({record.startEpoch, record.durationSec, app});
+                });
+        }
+        std::stable_sort(records.begin(), records.end(),
+                         [](const Record& a, const Record& b) { return a.startEpoch < b.startEpoch; });
+
+        if (!records.empty()) {
+            const std::int64_t span = records.back().startEpoch + records.back().duration - records.front().startEpoch;
+            constexpr std::int64_t kWeek = 7 * 24 * 3600;
+            loopShift = (span / kWeek + 1) * kWeek;
+        }
+        cursor = 0;
+        return records.size();
+    }
+
+    // ⏭️ Next recorded switch; false at the end of the recording (or when `stop` is requested mid-wait)
+    bool next(Step& step, std::stop_token stop = {}) {
+        if (records.empty() || cursor >= records.size() * passes) return false;
+        const Record& record = records[cursor % records.size()];
+        const std::int64_t start = record.startEpoch + static_cast<std::int64_t>(cursor / records.size()) * loopShift;
+
+        if (pace > 0.0 && cursor > 0) {
+            const double wait = static_cast<double>(start - previousStart) / pace;
+            std::unique_lock<std::mutex> lock(waitMutex);
+            wakeup.wait_for(lock, stop, std::chrono::duration<double>(wait), [] { return false; });
+            if (stop.stop_requested()) return false;
+        }
+
+        step.app = record.app;
+        step.at = Clock::time_point(Seconds(start));
+        step.awaySince = cursor > 0 && start - previousEnd > kGapToleranceSec ? Clock::time_point(Seconds(previousEnd))
+                                                                             : Clock::time_point::max();
+        current = record.app;
+        previousStart = start;
+        previousEnd = start + record.duration;
+        ++cursor;
+        return true;
+    }
+
+    // 🏁 End of the last replayed session (where the driver closes it)
+    Clock::time_point lastEnd() const { return Clock::time_point(Seconds(previousEnd)); }
+
+    std::size_t recordCount() const { return records.size(); }
+    std::size_t hidden() const { return hiddenCount; }
+
+    AppId frontmost() override { return current; }
+    void hideFrontmost() override { ++hiddenCount; }
+
+private:
+    struct Record {
+        std::int64_t startEpoch;
+        std::uint32_t duration;
+        AppId app;
+    };
+
+    const double pace;         // Recorded seconds per wall-clock second (0 = unpaced)
+    const std::size_t passes;  // Times the recording is played
+    std::vector<Record> records;
+    std::size_t cursor = 0;
+    std::int64_t loopShift = 0;
+    std::int64_t previousStart = 0;
+    std::int64_t previousEnd = 0;
+    AppId current = AppRegistry::kUnknown;
+    std::size_t hiddenCount = 0;
+
+    std::mutex waitMutex;
+    std::condition_variable_any wakeup;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <algorithm>    // For std::min
+#include <array>        // Fixed output buffer
+#include <cerrno>       // For EINTR
+#include <charconv>     // For std::to_chars (locale-free, allocation-free numbers)
+#include <cmath>        // For std::isfinite
+#include <concepts>     // For std::integral / std::same_as
+#include <cstring>      // For std::memcpy
+#include <string_view>  // Text is borrowed, never copied into a std::string
+
+// 🐧 POSIX output
+#include <unistd.h>
+
+// 📐 Formatting helpers for ReportWriter
+struct Fixed {           // Fixed-point number ("12.34")
+    double number;
+    int precision = 2;
+};
+
+struct Padded {          // Left-aligned text padded to `width` columns (std::setw + std::left)
+    std::string_view text;
+    std::size_t width;
+};
+
+struct MinSec {          // Seconds as "12m 5s"
+    long long seconds;
+};
+
+// 🖨️ Console report writer: a whole report is formatted into a fixed buffer and written to `fd` in one call
+//    - No iostreams, no locale, no heap: numbers go through std::to_chars
+//    - A report larger than the buffer is written in buffer-sized pieces, never truncated
+//    - One writer per thread (the buffer is not shared)
+class ReportWriter {
+public:
+    static constexpr std::size_t kBufferSize = 8 * 1024;
+
+    explicit ReportWriter(int outputFd = STDOUT_FILENO) : fd(outputFd) {}
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    ReportWriter& operator<<(std::string_view text) {
+        put(text.data(), text.size());
+        return *this;
+    }
+
+    ReportWriter& operator<<(const char* text) { return *this << std::string_view(text); }
+
+    ReportWriter& operator<<(char c) {
+        if (used == buffer.size()) flush();
+        buffer[used++] = c;
+        return *this;
+    }
+
+    template <std::integral Int>
+        requires(!std::same_as<Int, bool> && !std::same_as<Int, char>)
+    ReportWriter& operator<<(Int number) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        put(digits, static_cast<std::size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    ReportWriter& operator<<(Fixed fixed) {
+        if (!std::isfinite(fixed.number)) return *this << "nan";
+        char digits[48];
+        auto result = std::to_chars(digits, digits + sizeof(digits), fixed.number, std::chars_format::fixed,
+                                    fixed.precision);
+        if (result.ec != std::errc{}) { // Too wide for fixed notation: only absurd magnitudes
+            result = std::to_chars(digits, digits + sizeof(digits), fixed.number, std::chars_format::scientific,
+                                   fixed.precision);
+        }
+        put(digits, static_cast<std::size_t>(result.ptr - digits));
+        return *this;
+    }
+
+    ReportWriter& operator<<(Padded padded) {
+        *this << padded.text;
+        for (std::size_t i = padded.text.size(); i < padded.width; ++i) *this << ' ';
+        return *this;
+    }
+
+    ReportWriter& operator<<(MinSec time) { return *this << time.seconds / 60 << "m " << time.seconds % 60 << 's'; }
+
+    // 📤 Writes everything buffered so far (call once at the end of a report)
+    void flush() {
+        std::size_t written = 0;
+        while (written < used) {
+            ssize_t n = ::write(fd, buffer.data() + written, used - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break; // Console gone (closed pipe, detached daemon): drop the report
+            written += static_cast<std::size_t>(n);
+        }
+        used = 0;
+    }
+
+private:
+    void put(const char* data, std::size_t size) {
+        while (size > 0) {
+            if (used == buffer.size()) flush();
+            const std::size_t chunk = std::min(size, buffer.size() - used);
+            std::memcpy(buffer.data() + used, data, chunk);
+            used += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+    }
+
+    const int fd;
+    std::size_t used = 0;
+    std::array<char, kBufferSize> buffer;
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <cstddef>     // For event counts
+#include <cstdint>         // For category seconds
+#include <fstream>         // Daily text log
+#include <memory_resource> // Session table allocator (the analyzer's per-day arena)
+#include <span>            // Session tables from any container
+#include <string>          // Log file path
+#include <string_view>     // Dates
+
+#include "AppRegistry.hpp"      // Display names
+#include "AppSession.hpp"       // SwitchEvent, AppSession
+#include "BaselineModel.hpp"    // Hour-of-week usage baseline
+#include "BehaviorStats.hpp"    // Running aggregates
+#include "CategoryCounters.hpp" // Category snapshot type
+#include "GitHubActivity.hpp"   // ContributionCounts
+#include "ReportWriter.hpp"     // Console report formatting
+#include "UsageCategory.hpp"    // Category names
+
+// 🧠 Session update and report code shared by the agent (SystemObserver.mm) and the portable tools
+//    (LunrBench): nothing here touches AppKit, globals or threads, so it can be driven with synthetic streams
+
+// 🧠 Everything the analyzer thread owns: per-app sessions plus the running aggregates derived from them
+//    `sessions` allocates from `memory` (the agent passes its DayArena; tools get the default heap resource)
+struct AnalyzerState {
+    explicit AnalyzerState(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : sessions(memory) {}
+
+    std::pmr::vector<AppSession> sessions; // Indexed by AppId
+    BehaviorStats stats;
+    ContributionCounts contributions;          // GitHub activity counted today
+    BaselineModel baseline;                    // Usual seconds per category and hour-of-week (spans days)
+    CategoryCounters::Snapshot categoryBase{}; // Live counters when the day began (they never reset)
+
+    // 📅 Today's per-category seconds from a snapshot of the live, process-lifetime counters
+    CategoryCounters::Snapshot today(const CategoryCounters::Snapshot& live) const {
+        CategoryCounters::Snapshot day{};
+        for (std::size_t c = 0; c < kCategoryCount; ++c) day[c] = live[c] - categoryBase[c];
+        return day;
+    }
+
+    // 📅 Per-category seconds of the sessions in the table: the day's own totals. Unlike today(), this cannot
+    //    include credits the observer made after the day ended but before the analyzer drained them
+    CategoryCounters::Snapshot sessionTotals() const {
+        CategoryCounters::Snapshot day{};
+        for (const AppSession& session : sessions) {
+            const auto seconds = static_cast<std::uint64_t>(session.totalDuration.count());
+            day[static_cast<std::size_t>(session.category)] += seconds;
+        }
+        return day;
+    }
+
+    // 🌅 Starts a new day: sessions, stats and contributions reset, the baseline carries over. `closedDay` is the
+    //    finished day's sessionTotals(); the live counters past it (credits already made on the new day) stay
+    //    in today(). The old table is destroyed before returning, so the caller can release its arena right
+    //    after; returns yesterday's table size, to reserve once that memory is back (one allocation instead of
+    //    a regrowth chain)
+    std::size_t resetDay(const CategoryCounters::Snapshot& closedDay) {
+        const std::size_t apps = sessions.size();
+        std::pmr::vector<AppSession>(sessions.get_allocator()).swap(sessions);
+        stats = {};
+        contributions = {};
+        for (std::size_t c = 0; c < kCategoryCount; ++c) categoryBase[c] += closedDay[c];
+        return apps;
+    }
+};
+
+// 🩺 Pipeline losses shown at the end of a snapshot (zero in a healthy run)
+struct PipelineHealth {
+    std::size_t droppedEvents = 0; // Switch ring full
+    std::size_t unjournaled = 0;   // Flush ring full
+};
+
+// ➕ Folds one closed focus session into the analyzer-owned session table and aggregates
+inline void applySwitchEvent(AnalyzerState& state, const SwitchEvent& event) {
+    if (event.app >= state.sessions.size()) state.sessions.resize(event.app + 1); // Grows once per new app
+    AppSession& session = state.sessions[event.app];
+    session.app = event.app;
+    session.category = event.category; // The observer classified it; the analyzer never asks the classifier
+    session.totalDuration += event.duration;
+    session.focusHistogram.record(event.duration); // Constant memory per app
+    session.recentFocus.record(event.duration);
+
+    state.stats.record(session, event.duration); // O(1): no rescan of other apps
+    state.baseline.record(event.category, event.startTime, event.duration); // O(hours spanned)
+}
+
+// 🧠 Formats a behavior snapshot from the running aggregates and writes it in one call
+inline void writeBehaviorSnapshot(const AnalyzerState& state, const AppRegistry& registry,
+                                  const CategoryCounters::Snapshot& categories, PipelineHealth health,
+                                  Clock::time_point now, ReportWriter& out) {
+    const BehaviorStats& stats = state.stats;
+    out << "\n🧠 [Analyzer] Behavior Snapshot:\n";
+
+    out << " - Top App: " << registry.nameOf(stats.topApp) << " (" << MinSec{stats.topDuration.count()} << ")\n";
+    out << " - Total Switches: " << stats.totalSwitches << "\n";
+    out << " - Avg. Focus Time: " << Fixed{stats.meanFocus} << "s\n";
+    out << " - Focus Std. Dev.: " << Fixed{stats.focusStdDev()} << "s\n";
+    out << " - Fragmentation Index: " << Fixed{stats.fragmentationIndex()} << "\n";
+    for (std::size_t c = 0; c < kCategoryCount; ++c) {
+        const long long secs = static_cast<long long>(categories[c]);
+        if (secs == 0) continue;
+        out << " - " << categoryName(static_cast<UsageCategory>(c)) << ": " << MinSec{secs} << "\n";
+    }
+    for (std::size_t c = 0; c < kCategoryCount; ++c) {
+        const auto category = static_cast<UsageCategory>(c);
+        const std::uint32_t thisHour = state.baseline.currentHourSeconds(category, now);
+        const double z = state.baseline.zScore(category, now, thisHour);
+        if (z < 2.0) continue;
+        out << " - 📈 " << categoryName(category) << " this hour: " << thisHour / 60 << "m (usual by now "
+            << static_cast<long long>(state.baseline.expectedSoFar(category, now).mean) / 60 << "m, z=" << Fixed{z}
+            << ")\n";
+    }
+    const ContributionCounts& github = state.contributions;
+    if (github.total() > 0) {
+        out << " - GitHub: " << github.commits << " commits, " << github.pullRequests << " PRs, " << github.comments
+            << " comments\n";
+    }
+    if (health.droppedEvents > 0) {
+        out << " - Dropped Events: " << health.droppedEvents << "\n";
+    }
+    if (health.unjournaled > 0) {
+        out << " - Unjournaled Events: " << health.unjournaled << "\n";
+    }
+    out << "----------------------------------------\n";
+    out.flush();
+}
+
+// 📊 Formats the per-app usage summary and writes it in one call
+inline void writeUsageSummary(std::span<const AppSession> sessions, const AppRegistry& registry, ReportWriter& out) {
+    out << "\n✨ Daily App Usage Summary:\n";
+    for (const auto& session : sessions) {
+        if (session.focusHistogram.count() == 0) continue;
+        out << " - " << Padded{registry.nameOf(session.app), 20} << ": " << MinSec{session.totalDuration.count()}
+            << "  (" << session.focusHistogram.count() << " sessions, p50 "
+            << session.focusHistogram.percentile(0.5).count() << "s, p90 "
+            << session.focusHistogram.percentile(0.9).count() << "s)\n";
+    }
+    out.flush();
+}
+
+// 💾 Writes the legacy "App,12m 5s" day log (read back by HistoryReader for days without a journal)
+inline bool writeDailyLogFile(const std::string& path, std::string_view date, std::span<const AppSession> sessions,
+                              const AppRegistry& registry) {
+    std::ofstream file(path); // Create and open file
+
+    file << "📅 Date: " << date << "\n";
+    for (const auto& session : sessions) {
+        if (session.focusHistogram.count() == 0) continue; // Id interned but never credited
+        int mins = session.totalDuration.count() / 60;
+        int secs = session.totalDuration.count() % 60;
+        file << registry.nameOf(session.app) << "," << mins << "m " << secs << "s\n"; // CSV-like format
+    }
+    return static_cast<bool>(file.flush());
+}
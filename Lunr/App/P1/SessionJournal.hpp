@@ -0,0 +1,273 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <cerrno>      // For EINTR
+#include <chrono>      // For epoch conversion
+#include <cstdint>     // Fixed-width on-disk fields
+#include <cstring>     // For std::memcpy
+#include <string>      // For file paths
+#include <string_view> // Zero-copy names when walking a mapped journal
+#include <vector>      // Reusable write buffer and announced-id bitmap
+
+// 🐧 POSIX file I/O (unbuffered append + truncate of torn tails)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "AppRegistry.hpp" // AppId → name for string-table entries
+#include "AppSession.hpp"  // SwitchEvent
+#include "MappedFile.hpp"  // Walking an existing file on open
+
+// 📒 Lunr binary session journal (one file per day, append-only, native little-endian)
+//
+//    The file is an array of 16-byte slots, so it can be mmapped and walked without parsing:
+//      slot 0-1  JournalHeader
+//      then any mix of
+//        JournalRecord     one closed focus session
+//        JournalNameEntry  string-table entry: binds an app id to a name; followed by
+//                          ceil(length / 16) slots of UTF-8 bytes (NUL-padded)
+//
+//    A name entry is always written before the first record that uses its id, and a later entry for the same
+//    id overrides an earlier one (each agent run has its own registry), so readers resolve ids sequentially.
+namespace journal {
+
+constexpr std::size_t kSlot = 16;
+constexpr char kMagic[8] = {'L', 'U', 'N', 'R', 'J', 'N', 'L', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kNameTag = 0xFFFFFFFFu; // `app` value that marks a JournalNameEntry
+
+struct JournalHeader {
+    char magic[8];                // kMagic
+    std::uint32_t version;        // kVersion
+    std::uint32_t slotSize;       // kSlot
+    std::int64_t createdEpoch;    // When the file was created (seconds since epoch)
+    std::uint8_t reserved[8];
+};
+
+struct JournalRecord {
+    std::uint32_t app;            // AppId (never kNameTag)
+    std::uint32_t durationSec;    // Focus duration
+    std::int64_t startEpoch;      // Focus start (seconds since epoch)
+};
+
+struct JournalNameEntry {
+    std::uint32_t tag;            // kNameTag
+    std::uint32_t app;            // AppId being named
+    std::uint32_t length;         // Name length in bytes (no terminator)
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(JournalHeader) == 2 * kSlot, "header must span two slots");
+static_assert(sizeof(JournalRecord) == kSlot, "record must fill one slot");
+static_assert(sizeof(JournalNameEntry) == kSlot, "name entry must fill one slot");
+
+// 📐 Slots taken by a name entry including its payload
+inline std::size_t nameSlots(std::uint32_t length) { return 1 + (length + kSlot - 1) / kSlot; }
+
+// ✅ True if `data` starts with a journal header this reader understands
+inline bool isValid(const unsigned char* data, std::size_t size) {
+    if (size < sizeof(JournalHeader)) return false;
+    JournalHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 && header.version == kVersion &&
+           header.slotSize == kSlot;
+}
+
+// 🚶 Walks a mapped journal in place (no record copies):
+//      onName(AppId, std::string_view)   for each string-table entry (view points into `data`)
+//      onRecord(const JournalRecord&)    for each session
+//    A torn trailing slot or truncated name entry ends the walk. Returns the byte offset it stopped at (the
+//    end of the last complete entry, 0 for an invalid file), where a tailing reader resumes once the file grows
+template <typename OnName, typename OnRecord>
+std::size_t walk(const unsigned char* data, std::size_t size, OnName&& onName, OnRecord&& onRecord) {
+    if (!isValid(data, size)) return 0;
+
+    const std::size_t slots = size / kSlot;
+    std::size_t slot = sizeof(JournalHeader) / kSlot;
+    while (slot < slots) {
+        const unsigned char* at = data + slot * kSlot;
+        const auto* record = reinterpret_cast<const JournalRecord*>(at); // Slots are 16-byte aligned in the mapping
+
+        if (record->app != kNameTag) {
+            onRecord(*record);
+            ++slot;
+            continue;
+        }
+
+        const auto* entry = reinterpret_cast<const JournalNameEntry*>(at);
+        const std::size_t span = nameSlots(entry->length);
+        if (slot + span > slots) break;
+        onName(entry->app, std::string_view(reinterpret_cast<const char*>(at + kSlot), entry->length));
+        slot += span;
+    }
+    return slot * kSlot;
+}
+
+} // namespace journal
+
+// ✍️ Appends closed focus sessions to a day's journal
+//    add() only encodes into a reusable buffer; flush() hands the whole batch to the kernel in one write(),
+//    and sync() makes it durable. append() = add() + flush() for callers that write one session at a time.
+//    A batch lands whole or not at all: a short write is cut back off the file, so it always ends on a
+//    complete entry
+class SessionJournal {
+public:
+    SessionJournal() = default;
+    SessionJournal(const SessionJournal&) = delete;
+    SessionJournal& operator=(const SessionJournal&) = delete;
+    ~SessionJournal() { close(); }
+
+    // 📂 Opens (or creates) `path` for appending; returns false if the file cannot be used (or is not a journal)
+    bool open(const std::string& path) {
+        close();
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) return false;
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            close();
+            return false;
+        }
+        announced.clear(); // Ids must be re-announced: this run's registry may differ from the last one's
+        buffer.clear();
+        batchNames.clear();
+        batchRecords = 0;
+
+        const auto size = static_cast<std::size_t>(info.st_size);
+        if (size < sizeof(journal::JournalHeader)) {
+            if (size > 0 && ::ftruncate(fd, 0) != 0) { // Torn header: start the file over
+                close();
+                return false;
+            }
+            committed = 0;
+            journal::JournalHeader header{};
+            std::memcpy(header.magic, journal::kMagic, sizeof(header.magic));
+            header.version = journal::kVersion;
+            header.slotSize = journal::kSlot;
+            header.createdEpoch = toEpoch(Clock::now());
+            put(&header, sizeof(header));
+            if (!flush()) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        // A crash mid-write can leave a partial slot or a name entry without all of its name slots: cut the
+        // file back to the end of its last complete entry, or the next run's entries would be read as part
+        // of the torn one
+        std::size_t end = 0;
+        {
+            MappedFile existing;
+            if (existing.open(path)) {
+                end = journal::walk(existing.data(), existing.size(), [](AppId, std::string_view) {},
+                                    [](const journal::JournalRecord&) {});
+            }
+        }
+        if (end == 0 || (end < size && ::ftruncate(fd, static_cast<off_t>(end)) != 0)) {
+            close(); // Not a journal this build understands (never overwritten), or the cut failed
+            return false;
+        }
+        committed = end;
+        return true;
+    }
+
+    bool isOpen() const { return fd >= 0; }
+
+    // ➕ Buffers one session (plus its app's name entry the first time this file sees the id)
+    void add(const SwitchEvent& event, const AppRegistry& registry) {
+        if (fd < 0) {
+            ++lost; // No usable file for this day
+            return;
+        }
+
+        if (event.app >= announced.size()) announced.resize(event.app + 1, false);
+        if (!announced[event.app]) {
+            const std::string& name = registry.nameOf(event.app);
+            journal::JournalNameEntry entry{journal::kNameTag, event.app, static_cast<std::uint32_t>(name.size()), 0};
+            put(&entry, sizeof(entry));
+            put(name.data(), name.size());
+            pad();
+            announced[event.app] = true;
+            batchNames.push_back(event.app); // Un-announced again if this batch never reaches the file
+        }
+
+        journal::JournalRecord record{event.app, static_cast<std::uint32_t>(event.duration.count()),
+                                      toEpoch(event.startTime)};
+        put(&record, sizeof(record));
+        ++batchRecords;
+    }
+
+    void append(const SwitchEvent& event, const AppRegistry& registry) {
+        add(event, registry);
+        flush();
+    }
+
+    // 💾 One write() for everything buffered since the last flush (buffer capacity is reused).
+    //    On disk full / I/O error the batch is dropped rather than retried forever: whatever part of it landed
+    //    is truncated away (a fragment need not end on a slot, and every later append would be misaligned),
+    //    its names count as unannounced again and its sessions as dropped(). Returns false if it was dropped
+    bool flush() {
+        bool complete = fd >= 0;
+        std::size_t written = 0;
+        while (complete && written < buffer.size()) {
+            ssize_t n = ::write(fd, buffer.data() + written, buffer.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                complete = false;
+                break;
+            }
+            written += static_cast<std::size_t>(n);
+        }
+
+        if (complete) {
+            committed += buffer.size();
+        } else {
+            if (written > 0 && fd >= 0 && ::ftruncate(fd, static_cast<off_t>(committed)) != 0) {
+                ::close(fd); // Cannot restore alignment: stop appending (the next open() repairs the tail)
+                fd = -1;
+            }
+            for (AppId id : batchNames) announced[id] = false;
+            lost += batchRecords;
+        }
+        buffer.clear();
+        batchNames.clear();
+        batchRecords = 0;
+        return complete;
+    }
+
+    // 📉 Sessions that never reached a file (failed writes, or no open journal) since construction
+    std::size_t dropped() const { return lost; }
+
+    // 🔒 Forces written batches to stable storage (slow: call periodically, never per session)
+    void sync() {
+        if (fd >= 0) ::fsync(fd);
+    }
+
+    void close() {
+        if (fd < 0) return;
+        flush();
+        ::close(fd);
+        fd = -1;
+    }
+
+private:
+    static std::int64_t toEpoch(Clock::time_point t) {
+        return std::chrono::duration_cast<Seconds>(t.time_since_epoch()).count();
+    }
+
+    void put(const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    void pad() { buffer.resize((buffer.size() + journal::kSlot - 1) / journal::kSlot * journal::kSlot, 0); }
+
+    int fd = -1;
+    std::uint64_t committed = 0;       // File size after the last complete batch
+    std::vector<unsigned char> buffer; // Pending bytes (slot-aligned)
+    std::vector<bool> announced;       // Ids whose name entry is already in this file (this run)
+    std::vector<AppId> batchNames;     // Ids announced by the pending batch
+    std::size_t batchRecords = 0;      // Sessions in the pending batch
+    std::size_t lost = 0;              // Sessions dropped (see dropped())
+};
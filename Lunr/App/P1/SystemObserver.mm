@@ -1,42 +1,349 @@
 // 🍎 macOS-specific header for accessing currently active (frontmost) applications
 #import <AppKit/AppKit.h> // Provides macOS GUI and app management APIs
+#import <ApplicationServices/ApplicationServices.h> // Accessibility (window titles) for tab attribution
 
 // 🧱 Standard C++ libraries
 #include <iostream>      // For console I/O
-#include <unordered_map> // For storing app sessions with app name as key
+#include <unordered_map> // For caching pid → app id
+#include <memory_resource> // Pooled pid-cache nodes
+#include <vector>        // Flat session table indexed by app id
 #include <string>        // For using std::string
+#include <string_view>   // Borrowed window titles and site names
+#include <memory>        // Owned tab attribution backends
 #include <chrono>        // For time tracking
-#include <thread>        // For sleep and concurrent execution
-#include <mutex>         // For thread-safe access (critical sections)
-#include <vector>        // To store multiple session durations
+#include <thread>        // For std::jthread and concurrent execution
+#include <stop_token>    // For cooperative, immediate shutdown
+#include <mutex>         // For the analyzer's timed wait
+#include <condition_variable> // For waking threads early on shutdown
 #include <algorithm>     // For possible future enhancements
 #include <numeric>       // For reducing data, e.g., average focus time
-#include <iomanip>       // For formatting output (precision)
 #include <fstream>       // For writing logs to file
 #include <ctime>         // For getting current date/time
+#include <csignal>       // For routing SIGUSR1 to the metrics dump
+#include <cstdlib>       // For std::atoi
+
+// 🧩 Lunr modules
+#include "AppRegistry.hpp"        // App-name intern table
+#include "AppSession.hpp"         // Clock aliases, AppSession, SwitchEvent
+#include "EventRing.hpp"          // Lock-free SPSC handoff between observer and analyzer
+#include "BehaviorStats.hpp"      // Incremental analyzer aggregates
+#include "FlushThread.hpp"        // Batched journal writer with midnight rotation
+#include "Instrumentation.hpp"    // Hot-path counters and latency histograms
+#include "CategoryClassifier.hpp" // Perfect-hash app → category table + user overlay
+#include "CategoryCounters.hpp"   // Padded per-category atomics with consistent snapshots
+#include "TabAttribution.hpp"     // Browser tab → per-site app ids
+#include "AdaptiveInterval.hpp"   // Back-off / tighten schedule for the polling fallback
+#include "DayExport.hpp"          // Streaming JSON day file for dashboards
+#include "Checkpoint.hpp"         // Crash-safe snapshot of the day's aggregates
+#include "GitHubActivity.hpp"     // Conditional-request GitHub poller
+#include "BaselineModel.hpp"      // EWMA usage baseline per category and hour-of-week
+#include "EnforcementEngine.hpp"  // Flat-table block / warn rules checked on every switch
+#include "FocusObserver.hpp"      // Observer core shared by every focus source
+#include "FocusSource.hpp"        // Focus backend interface (NSWorkspace here, replay in LunrReplay)
+#include "ReportWriter.hpp"       // Buffered, allocation-free console reports
+#include "SessionAnalysis.hpp"    // Analyzer state, session update and report formatting
+#include "DayArena.hpp"           // Per-day monotonic arena for the analyzer's session table
+#include "LocalDay.hpp"           // Local-midnight bounds for the analyzer's day rotation
+#include "FleetUploader.hpp"      // Ships journal batches to a LunrFleet aggregation service
+
+// 📨 Closed sessions flow observer → analyzer through this ring; the observer never waits on the analyzer
+EventRing<SwitchEvent, 1024> switchEvents;
+
+// 🐙 Contribution deltas flow GitHub thread → analyzer through their own ring (each ring keeps one producer)
+EventRing<ContributionEvent, 64> contributionEvents;
+
+// 🛑 Process-wide shutdown request (Enter on stdin); observer loops wake on it immediately
+std::stop_source shutdownSource;
+
+// 📡 Hot-path metrics (off unless --metrics is passed; dump on demand with `kill -USR1 <pid>`)
+Instrumentation metrics;
+
+// 📇 Names and bundle identifiers → dense ids (interned by the observer thread, read by everyone)
+AppRegistry appRegistry;
+
+// ⚡ pid → resolved app info, so the per-sample path compares integers instead of building strings
+//    Observer thread only; entries are dropped when the app terminates (event mode), and their nodes go back to
+//    an unsynchronized pool so launch / quit churn reuses the same few blocks instead of hitting malloc
+struct PidInfo {
+    AppId id = AppRegistry::kUnknown;           // Interned app
+    int tabBackend = TabAttributor::kNoBackend; // Browser attribution backend, if the app is a known browser
+    std::string bundleId;                       // Kept for browsers only (backend queries need it)
+};
+std::pmr::unsynchronized_pool_resource pidPool;
+std::pmr::unordered_map<pid_t, PidInfo> pidCache{&pidPool};
+
+// 🌐 Browser tab attribution (observer thread only; disabled with --no-tabs)
+TabAttributor tabAttributor;
+bool tabAttributionEnabled = true;
+
+// 🤫 Headless daemon (--quiet): no heartbeat and no periodic snapshots; set before any thread starts
+bool quietMode = false;
+
+// 🗂️ App → category, resolved once per AppId on the observer thread (user rules from lunr_categories.txt)
+CategoryClassifier classifier;
+
+// ⏲️ Live seconds per category, credited by the observer at each switch; any thread may snapshot()
+CategoryCounters categoryUsage;
+
+// 🔒 Enforcement rules from lunr_rules.txt (observer thread only; bound to ids as they are interned)
+EnforcementEngine enforcement;
+
+// 🐙 Today's GitHub contributions as last drained by the analyzer (read by the enforcement gate)
+std::atomic<std::uint32_t> contributionsToday{0};
+
+// 📒 Binary journal of every closed session; the observer only enqueues, the flush thread does the I/O
+FlushThread flushThread(appRegistry, metrics);
 
-// ⏱ Aliases for cleaner chrono usage
-using Clock = std::chrono::system_clock;
-using Seconds = std::chrono::seconds;
+// 🍎 AppleScript tab backend: asks a browser for its active tab URL (needs the Automation permission)
+class AppleScriptTabBackend : public TabAttributionBackend {
+public:
+    // `tabExpression` is the browser's AppleScript for the URL, e.g. "URL of current tab of front window"
+    AppleScriptTabBackend(std::vector<std::string> bundleIds, std::string tabExpression)
+        : bundles(std::move(bundleIds)), expression(std::move(tabExpression)) {}
 
-// 🗃️ Structure to hold session data for each app
-struct AppSession {
-    std::string appName;                 // Name of the application
-    Clock::time_point startTime;         // Start time of the current session
-    Seconds totalDuration = Seconds(0);  // Total accumulated time used
-    std::vector<Seconds> focusDurations; // Stores individual focus durations (time between switches)
+    bool handles(std::string_view bundleId) const override {
+        return std::find(bundles.begin(), bundles.end(), bundleId) != bundles.end();
+    }
+
+    std::string activeTabURL(std::string_view bundleId) override {
+        auto timer = metrics.time(Probe::TabQuery);
+        @autoreleasepool {
+            NSDictionary* error = nil;
+            NSAppleEventDescriptor* result = [scriptFor(bundleId) executeAndReturnError:&error];
+            NSString* url = result ? [result stringValue] : nil;
+            return url ? std::string([url UTF8String]) : std::string();
+        }
+    }
+
+private:
+    // 🧾 Compiled once per browser, then reused for every query
+    NSAppleScript* scriptFor(std::string_view bundleId) {
+        std::string key(bundleId);
+        auto cached = scripts.find(key);
+        if (cached != scripts.end()) return cached->second;
+
+        std::string source = "tell application id \"" + key + "\" to get " + expression;
+        NSAppleScript* script = [[NSAppleScript alloc] initWithSource:[NSString stringWithUTF8String:source.c_str()]];
+        [script compileAndReturnError:nil];
+        scripts.emplace(key, script);
+        return script;
+    }
+
+    std::vector<std::string> bundles;
+    std::string expression;
+    std::unordered_map<std::string, NSAppleScript*> scripts;
 };
 
-// 🔐 Mutex to synchronize access to session data across threads
-std::mutex sessionMutex;
+// 🪟 Title of an app's focused window via Accessibility ("" without the Accessibility permission)
+//    Written into `buffer`, so the per-sample path allocates nothing
+std::string_view focusedWindowTitle(pid_t pid, char* buffer, std::size_t size) {
+    std::string_view title;
+    AXUIElementRef appElement = AXUIElementCreateApplication(pid);
+    CFTypeRef window = nullptr;
+    if (AXUIElementCopyAttributeValue(appElement, kAXFocusedWindowAttribute, &window) == kAXErrorSuccess && window) {
+        CFTypeRef value = nullptr;
+        if (AXUIElementCopyAttributeValue((AXUIElementRef)window, kAXTitleAttribute, &value) == kAXErrorSuccess &&
+            value) {
+            if (CFGetTypeID(value) == CFStringGetTypeID() &&
+                CFStringGetCString((CFStringRef)value, buffer, static_cast<CFIndex>(size), kCFStringEncodingUTF8)) {
+                title = buffer;
+            }
+            CFRelease(value);
+        }
+        CFRelease(window);
+    }
+    CFRelease(appElement);
+    return title;
+}
+
+// 🆔 Interns an app on first sight of its pid (bundle id is the stable key; display name for unbundled processes)
+const PidInfo& pidInfoOf(NSRunningApplication* app) {
+    pid_t pid = [app processIdentifier];
+    auto cached = pidCache.find(pid);
+    if (cached != pidCache.end()) return cached->second;
+
+    NSString* bundle = [app bundleIdentifier];
+    NSString* name = [app localizedName];
+    const char* key = bundle ? [bundle UTF8String] : (name ? [name UTF8String] : "");
+    const char* display = name ? [name UTF8String] : key;
+
+    PidInfo info;
+    info.id = appRegistry.intern(key, display);
+    classifier.assign(info.id, key, display);
+    enforcement.bindApp(info.id, key, display);
+    if (tabAttributionEnabled && bundle) {
+        info.tabBackend = tabAttributor.backendFor(key);
+        if (info.tabBackend != TabAttributor::kNoBackend) info.bundleId = key;
+    }
+    return pidCache.emplace(pid, std::move(info)).first->second;
+}
+
+// 🆔 Resolves an NSRunningApplication to its interned id; for browsers, to the active tab's per-site id
+AppId appIdOf(NSRunningApplication* app) {
+    if (app == nil) return AppRegistry::kUnknown;
+
+    const PidInfo& info = pidInfoOf(app);
+    if (info.tabBackend == TabAttributor::kNoBackend) {
+        tabAttributor.invalidate(); // Focus left the browser: re-query when it comes back
+        return info.id;
+    }
+
+    // Only a changed pid or window title triggers a backend round-trip
+    pid_t pid = [app processIdentifier];
+    char titleBuffer[1024];
+    std::string_view title = focusedWindowTitle(pid, titleBuffer, sizeof(titleBuffer));
+    return tabAttributor.resolve(info.tabBackend, info.bundleId, pid, title, info.id, [&](std::string_view site) {
+        std::string siteKey = info.bundleId + "|" + std::string(site);
+        std::string display = appRegistry.nameOf(info.id) + " · " + std::string(site);
+        AppId siteId = appRegistry.intern(siteKey, display);
+        classifier.assign(siteId, site, display); // Sites classify by domain ("youtube.com" → Entertainment)
+        enforcement.bindApp(siteId, site, display);
+        return siteId;
+    });
+}
 
-// 🍏 Gets the name of the current frontmost application (macOS only)
-std::string getFrontmostApp() {
-    NSRunningApplication* frontmost = [[NSWorkspace sharedWorkspace] frontmostApplication];
-    NSString* name = [frontmost localizedName];
-    return std::string([name UTF8String]); // Convert NSString to std::string
+// 🌐 True if `app` is a browser we attribute per tab
+bool isAttributedBrowser(NSRunningApplication* app) {
+    return app != nil && pidInfoOf(app).tabBackend != TabAttributor::kNoBackend;
 }
 
+// 🐙 GitHub transport on one NSURLSession: a single keep-alive connection to api.github.com, reused every poll.
+//    The URL cache is off so our own If-None-Match reaches the server and 304s reach the poller unchanged
+class URLSessionGitHubTransport : public GitHubTransport {
+public:
+    explicit URLSessionGitHubTransport(std::string authToken) : token(std::move(authToken)) {
+        NSURLSessionConfiguration* config = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+        config.URLCache = nil;
+        config.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        config.HTTPMaximumConnectionsPerHost = 1;
+        config.timeoutIntervalForRequest = 30;
+        config.HTTPAdditionalHeaders = @{
+            @"Accept" : @"application/vnd.github+json",
+            @"User-Agent" : @"Lunr",
+            @"X-GitHub-Api-Version" : @"2022-11-28"
+        };
+        session = [NSURLSession sessionWithConfiguration:config];
+        dates = [[NSISO8601DateFormatter alloc] init];
+    }
+
+    GitHubResponse fetchEvents(std::string_view user, std::string_view etag) override {
+        GitHubResponse out;
+        @autoreleasepool {
+            std::string url = "https://api.github.com/users/" + std::string(user) + "/events?per_page=100";
+            NSMutableURLRequest* request =
+                [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@(url.c_str())]];
+            if (!etag.empty()) {
+                [request setValue:@(std::string(etag).c_str()) forHTTPHeaderField:@"If-None-Match"];
+            }
+            if (!token.empty()) {
+                [request setValue:@(("Bearer " + token).c_str()) forHTTPHeaderField:@"Authorization"];
+            }
+
+            // Blocking is fine here: this runs on the GitHub thread only
+            __block NSData* body = nil;
+            __block NSHTTPURLResponse* http = nil;
+            dispatch_semaphore_t done = dispatch_semaphore_create(0);
+            [[session dataTaskWithRequest:request
+                        completionHandler:^(NSData* data, NSURLResponse* response, NSError* error) {
+                          if (!error && [response isKindOfClass:[NSHTTPURLResponse class]]) {
+                              body = data;
+                              http = (NSHTTPURLResponse*)response;
+                          }
+                          dispatch_semaphore_signal(done);
+                        }] resume];
+            dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER); // Bounded by timeoutIntervalForRequest
+            if (!http) return out;
+
+            out.status = static_cast<int>(http.statusCode);
+            if (NSString* tag = [http valueForHTTPHeaderField:@"ETag"]) out.etag = [tag UTF8String];
+            out.pollIntervalSec = [[http valueForHTTPHeaderField:@"X-Poll-Interval"] intValue];
+            if (NSString* remaining = [http valueForHTTPHeaderField:@"X-RateLimit-Remaining"]) {
+                out.rateRemaining = [remaining intValue];
+            }
+            out.rateResetEpoch = [[http valueForHTTPHeaderField:@"X-RateLimit-Reset"] longLongValue];
+            if (out.status == 200 && body) parseEvents(body, out.events);
+        }
+        return out;
+    }
+
+private:
+    // 🧾 Keeps only what counts as a contribution; everything else becomes a zero-count event (still advances
+    //    the cursor)
+    void parseEvents(NSData* body, std::vector<GitHubEvent>& events) {
+        id json = [NSJSONSerialization JSONObjectWithData:body options:0 error:nil];
+        if (![json isKindOfClass:[NSArray class]]) return;
+        events.reserve([(NSArray*)json count]);
+        for (id item in (NSArray*)json) {
+            if (![item isKindOfClass:[NSDictionary class]]) continue;
+            NSDictionary* event = item;
+            NSString* type = event[@"type"];
+            NSString* created = event[@"created_at"];
+            NSDictionary* payload = event[@"payload"];
+            if (![type isKindOfClass:[NSString class]] || ![created isKindOfClass:[NSString class]]) continue;
+            if (![payload isKindOfClass:[NSDictionary class]]) payload = nil;
+
+            GitHubEvent parsed;
+            parsed.createdEpoch = static_cast<std::int64_t>([[dates dateFromString:created] timeIntervalSince1970]);
+            if ([type isEqualToString:@"PushEvent"]) {
+                id size = payload[@"distinct_size"];
+                parsed.counts.commits = [size isKindOfClass:[NSNumber class]] ? [size unsignedIntValue] : 1;
+            } else if ([type isEqualToString:@"PullRequestEvent"]) {
+                parsed.counts.pullRequests = [payload[@"action"] isEqual:@"opened"] ? 1 : 0;
+            } else if ([type isEqualToString:@"IssueCommentEvent"] ||
+                       [type isEqualToString:@"PullRequestReviewCommentEvent"] ||
+                       [type isEqualToString:@"CommitCommentEvent"]) {
+                parsed.counts.comments = 1;
+            }
+            events.push_back(parsed);
+        }
+    }
+
+    std::string token;
+    NSURLSession* session;
+    NSISO8601DateFormatter* dates;
+};
+
+// 💤 Idle threshold: no HID input for this long closes the session at the last input (--idle <seconds>)
+Seconds idleThreshold(300);
+
+// ⌨️ Seconds since the last keyboard / mouse / trackpad event, system-wide
+double secondsSinceLastInput() {
+    return CGEventSourceSecondsSinceLastEventType(kCGEventSourceStateHIDSystemState, kCGAnyInputEventType);
+}
+
+// 🕰️ Time of the last HID input
+Clock::time_point lastInputTime(Clock::time_point now) {
+    return now - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(secondsSinceLastInput()));
+}
+
+// ⏰ Event mode arms this at ObserverState::enforceAt (null in polling mode, which caps its wait instead)
+CFRunLoopTimerRef enforcementTimer = nullptr;
+
+// 🍎 NSWorkspace focus backend: the live desktop
+class WorkspaceFocusSource : public FocusSource {
+public:
+    AppId frontmost() override {
+        auto timer = metrics.time(Probe::FrontmostApp);
+        @autoreleasepool { // Drain AppKit temporaries on every sample
+            return appIdOf([[NSWorkspace sharedWorkspace] frontmostApplication]);
+        }
+    }
+
+    void hideFrontmost() override { [[NSWorkspace sharedWorkspace].frontmostApplication hide]; }
+
+    void scheduleRecheck(Seconds delay) override {
+        if (enforcementTimer) {
+            CFRunLoopTimerSetNextFireDate(enforcementTimer, CFAbsoluteTimeGetCurrent() + delay.count());
+        }
+    }
+};
+
+WorkspaceFocusSource workspaceSource;
+
+// 👁️ Observer core: session boundaries, analyzer / journal handoff and enforcement (observer thread only)
+FocusObserver focus(workspaceSource, switchEvents, &flushThread, classifier, categoryUsage, enforcement,
+                    contributionsToday, metrics);
+
 // 📅 Returns current date as a string in YYYY-MM-DD format
 std::string getCurrentDateString() {
     std::time_t now = std::time(nullptr);     // Get current system time
@@ -45,135 +352,528 @@ std::string getCurrentDateString() {
     return std::string(buf);
 }
 
-// 💾 Writes daily usage log to a file with the current date in its filename
-void writeDailyLog(const std::unordered_map<std::string, AppSession>& sessions) {
-    std::string filename = "lunr_log_" + getCurrentDateString() + ".log";
-    std::ofstream file(filename); // Create and open file
+// 💾 Writes the usage log of `date` (YYYY-MM-DD) to a file named after it
+void writeDailyLog(std::span<const AppSession> sessions, std::string_view date) {
+    std::string filename = "lunr_log_" + std::string(date) + ".log";
+    writeDailyLogFile(filename, date, sessions, appRegistry);
+    std::cout << "\n📁 Log saved to " << filename << "\n";
+}
 
-    file << "📅 Date: " << getCurrentDateString() << "\n";
-    for (const auto& [app, session] : sessions) {
-        int mins = session.totalDuration.count() / 60;
-        int secs = session.totalDuration.count() % 60;
-        file << app << "," << mins << "m " << secs << "s\n"; // CSV-like format
-    }
+// 📊 Prints usage summary in terminal (pending iostream output goes first, then the report in one write)
+void printSummary(std::span<const AppSession> sessions, ReportWriter& out) {
+    std::cout.flush();
+    writeUsageSummary(sessions, appRegistry, out);
+}
 
-    file.close();
-    std::cout << "\n📁 Log saved to " << filename << "\n";
+// 🧠 Prints a behavior snapshot from the running aggregates (called every 30 seconds)
+void analyzeBehavior(const AnalyzerState& state, ReportWriter& out) {
+    std::cout.flush();
+    writeBehaviorSnapshot(state, appRegistry, state.today(categoryUsage.snapshot()), // One consistent instant
+                          PipelineHealth{switchEvents.dropped(), flushThread.dropped()}, Clock::now(), out);
 }
 
-// 📊 Prints usage summary in terminal
-void printSummary(const std::unordered_map<std::string, AppSession>& sessions) {
-    std::cout << "\n✨ Daily App Usage Summary:\n";
-    for (const auto& [app, session] : sessions) {
-        int mins = session.totalDuration.count() / 60;
-        int secs = session.totalDuration.count() % 60;
-        std::cout << " - " << std::setw(20) << std::left << app
-                  << ": " << mins << "m " << secs << "s\n";
+// 📤 Exports the day `date` as JSON to ~/Library/Application Support/Lunr/logs/YYYY-MM-DD.json
+void exportDailyJson(const AnalyzerState& state, std::string_view date,
+                     const CategoryCounters::Snapshot& categoryTotals) {
+    char host[256] = {};
+    gethostname(host, sizeof(host) - 1);
+    const auto path = day_export::exportDay(
+        day_export::defaultDirectory(), date, host, state.sessions, appRegistry, categoryTotals, state.stats,
+        state.contributions);
+    if (path.empty()) {
+        std::cout << "⚠️ JSON export failed.\n";
+    } else {
+        std::cout << "📤 JSON exported to " << path.string() << "\n";
     }
 }
 
-// 🧠 Analyzes user behavior from app usage (called every 30 seconds)
-void analyzeBehavior(const std::unordered_map<std::string, AppSession>& sessions) {
-    std::cout << "\n🧠 [Analyzer] Behavior Snapshot:\n";
+// 💾 Snapshot of the analyzer's day, rewritten after every analysis tick (a restart loses at most one tick)
+constexpr const char* kCheckpointPath = "lunr_checkpoint.bin";
+
+// 🔄 Owns the background analyzer thread and everything it aggregates
+//    Drains switch events, runs behavior analysis and checkpoints every 30 seconds; stop() is immediate and
+//    flushes the ring. At local midnight it writes the finished day's log and JSON, then releases the day's
+//    arena in one shot and starts the next day on the same memory
+class BehaviorAnalyzer {
+public:
+    // ♻️ Seeds the aggregates from a checkpoint (before start()); sessions are copied into the day's arena
+    void restore(const checkpoint::Restored& restored) {
+        analyzerState.sessions.assign(restored.sessions.begin(), restored.sessions.end());
+        analyzerState.stats = restored.stats;
+        analyzerState.contributions = restored.contributions;
+        analyzerState.baseline = restored.baseline; // Carries over into a new day
+        contributionsToday.store(analyzerState.contributions.total(), std::memory_order_relaxed);
+    }
+
+    void start() {
+        worker = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    // 🛑 Wakes the thread, lets it drain the ring one last time, and joins it
+    void stop() {
+        worker.request_stop();
+        if (worker.joinable()) worker.join();
+    }
 
-    int totalSwitches = 0;
-    Seconds totalFocusTime(0);
-    std::string topApp;
-    int maxDuration = 0;
+    // 📦 Aggregates and the day they cover; only read these once stop() has returned
+    const AnalyzerState& state() const { return analyzerState; }
+    std::string_view date() const { return day.date; }
+
+private:
+    void drainEvents() {
+        auto timer = metrics.time(Probe::AnalyzerDrain);
+        std::size_t drained = switchEvents.drain([this](const SwitchEvent& event) {
+            const std::time_t start = Clock::to_time_t(event.startTime);
+            if (start >= day.end) rotateDay(start); // First session of a new day
+            applySwitchEvent(analyzerState, event);
+        });
+        metrics.count(Counter::EventsDrained, drained);
+        contributionEvents.drain([this](const ContributionEvent& event) {
+            analyzerState.contributions.add(event.delta);
+        });
+        contributionsToday.store(analyzerState.contributions.total(), std::memory_order_relaxed); // Gate rules
+    }
 
-    // Determine most used app, total time, number of switches
-    for (const auto& [app, session] : sessions) {
-        int duration = session.totalDuration.count();
-        if (duration > maxDuration) {
-            maxDuration = duration;
-            topApp = app;
+    void run(std::stop_token stop) {
+        std::unique_lock<std::mutex> lock(wakeupMutex);
+        while (!stop.stop_requested()) {
+            // Timed wait that returns early as soon as stop is requested (no notify needed)
+            wakeup.wait_for(lock, stop, std::chrono::seconds(30), [] { return false; });
+            if (stop.stop_requested()) break;
+
+            metrics.count(Counter::AnalyzerWakeups);
+            drainEvents();
+            if (const std::time_t now = std::time(nullptr); now >= day.end) rotateDay(now); // Midnight passed idle
+            metrics.set(Gauge::ArenaSpillBytes, static_cast<std::uint64_t>(arena.spilledBytes()));
+            {
+                auto timer = metrics.time(Probe::Analyze);
+                if (!quietMode) analyzeBehavior(analyzerState, report);
+            }
+            saveCheckpoint();
+            if (metrics.enabled()) metrics.dump(std::cout); // Periodic dump alongside each snapshot
         }
+        drainEvents(); // Final flush: pick up the last session pushed by main
+        saveCheckpoint();
+    }
+
+    // 🌅 Closes out the finished day and starts the one containing `t`
+    void rotateDay(std::time_t t) {
+        // The day's own sessions, not the live counters: those may already hold credits from after midnight
+        const CategoryCounters::Snapshot closedDay = analyzerState.sessionTotals();
+        writeDailyLog(analyzerState.sessions, day.date);
+        exportDailyJson(analyzerState, day.date, closedDay);
+
+        const std::size_t apps = analyzerState.resetDay(closedDay);
+        arena.release();                      // Yesterday's table and all its regrowths, in one call
+        analyzerState.sessions.reserve(apps); // Back at the start of the same block
+        contributionsToday.store(0, std::memory_order_relaxed);
+        day = localDayOf(t);
+    }
+
+    void saveCheckpoint() {
+        auto timer = metrics.time(Probe::Checkpoint);
+        checkpointWriter.save(kCheckpointPath, day.date, analyzerState.sessions, analyzerState.stats,
+                              analyzerState.contributions, analyzerState.today(categoryUsage.snapshot()),
+                              analyzerState.baseline, appRegistry);
+    }
+
+    DayArena arena;                                // Declared before the state that allocates from it
+    AnalyzerState analyzerState{arena.resource()};
+    LocalDay day = localDayOf(std::time(nullptr)); // The day the aggregates cover
+    checkpoint::Writer checkpointWriter; // Reuses its encode buffer every tick
+    ReportWriter report;                 // Snapshot buffer (analyzer thread only)
+    std::mutex wakeupMutex;
+    std::condition_variable_any wakeup;
+    std::jthread worker; // Declared last: destroyed (and joined) before the state it uses
+};
+
+// ⌨️ Exit condition: Enter on stdin requests shutdown for every thread
+std::jthread startExitWatcher() {
+    return std::jthread([] {
+        std::cin.get();
+        shutdownSource.request_stop();
+    });
+}
+
+// 🪟 Watches the frontmost browser's window titles (event mode) so tab switches are recorded as they happen
+AXObserverRef titleObserver = nullptr;
+pid_t titleObserverPid = 0;
+
+void stopTitleObserver() {
+    if (!titleObserver) return;
+    CFRunLoopRemoveSource(CFRunLoopGetMain(), AXObserverGetRunLoopSource(titleObserver), kCFRunLoopDefaultMode);
+    CFRelease(titleObserver);
+    titleObserver = nullptr;
+    titleObserverPid = 0;
+}
 
-        totalFocusTime += session.totalDuration;
-        totalSwitches += session.focusDurations.size();
+void onBrowserTitleChanged(AXObserverRef, AXUIElementRef, CFStringRef, void* refcon) {
+    metrics.count(Counter::ObserverWakeups);
+    @autoreleasepool {
+        NSRunningApplication* app = [NSRunningApplication runningApplicationWithProcessIdentifier:titleObserverPid];
+        // No-op if the site is unchanged
+        focus.recordSwitch(*static_cast<ObserverState*>(refcon), appIdOf(app), Clock::now());
     }
+}
+
+void startTitleObserver(pid_t pid, ObserverState* state) {
+    if (titleObserver && titleObserverPid == pid) return;
+    stopTitleObserver();
+    if (AXObserverCreate(pid, onBrowserTitleChanged, &titleObserver) != kAXErrorSuccess) {
+        titleObserver = nullptr; // No Accessibility permission: attribution still refreshes on every activation
+        return;
+    }
+
+    // Registering on the application element covers every window it owns
+    AXUIElementRef appElement = AXUIElementCreateApplication(pid);
+    AXObserverAddNotification(titleObserver, appElement, kAXTitleChangedNotification, state);
+    AXObserverAddNotification(titleObserver, appElement, kAXFocusedWindowChangedNotification, state);
+    CFRelease(appElement);
+    CFRunLoopAddSource(CFRunLoopGetMain(), AXObserverGetRunLoopSource(titleObserver), kCFRunLoopDefaultMode);
+    titleObserverPid = pid;
+}
+
+// ⏰ Idle watchdog (event mode): one-shot timer aimed at the moment the idle threshold would be crossed,
+//    so an active user costs one wakeup per threshold period and a locked / sleeping machine costs none
+constexpr double kAwayRecheckSeconds = 15.0; // While idle with the screen on, how often to look for input
+CFRunLoopTimerRef idleTimer = nullptr;
 
-    // Calculate average focus time per session switch
-    double avgFocus = totalSwitches ? totalFocusTime.count() / static_cast<double>(totalSwitches) : 0;
+void scheduleIdleCheck(double seconds) {
+    CFRunLoopTimerSetNextFireDate(idleTimer, CFAbsoluteTimeGetCurrent() + seconds);
+}
 
-    std::cout << " - Top App: " << topApp << " (" << maxDuration / 60 << "m " << maxDuration % 60 << "s)\n";
-    std::cout << " - Total Switches: " << totalSwitches << "\n";
-    std::cout << " - Avg. Focus Time: " << std::fixed << std::setprecision(2) << avgFocus << "s\n";
-    std::cout << " - Fragmentation Index: " << (totalSwitches > 0 ? 100.0 / totalSwitches : 0) << "\n";
-    std::cout << "----------------------------------------\n";
+void parkIdleCheck() {
+    CFRunLoopTimerSetNextFireDate(idleTimer, CFAbsoluteTimeGetCurrent() + 1.0e10); // Effectively never
 }
 
-// 🔄 Background thread that runs behavior analysis every 30 seconds
-void startBehaviorAnalyzer(const std::unordered_map<std::string, AppSession>* sharedSessions) {
-    while (true) {
-        std::this_thread::sleep_for(std::chrono::seconds(30)); // Wait before analysis
+void onIdleCheck(ObserverState& state) {
+    metrics.count(Counter::ObserverWakeups);
+    if (state.locked || state.asleep) { // Lock / wake notifications take over
+        parkIdleCheck();
+        return;
+    }
+
+    const double threshold = static_cast<double>(idleThreshold.count());
+    const double idle = secondsSinceLastInput();
+    Clock::time_point now = Clock::now();
 
-        // Take a thread-safe snapshot of sessions
-        std::unordered_map<std::string, AppSession> snapshot;
-        {
-            std::lock_guard<std::mutex> lock(sessionMutex);
-            snapshot = *sharedSessions;
+    if (!state.away && idle >= threshold) {
+        focus.markAway(state, lastInputTime(now));
+        scheduleIdleCheck(kAwayRecheckSeconds);
+        return;
+    }
+    if (state.away) {
+        if (idle >= kAwayRecheckSeconds) { // Still away
+            scheduleIdleCheck(kAwayRecheckSeconds);
+            return;
         }
+        focus.markBack(state, focus.frontmost(), lastInputTime(now));
+    }
+    scheduleIdleCheck(threshold - idle); // Next possible crossing
+}
 
-        // Analyze and print the snapshot
-        analyzeBehavior(snapshot);
+// 🔒 Lock / sleep: close the session at the last input and stop all timers until unlock / wake
+void pauseObservation(ObserverState& state) {
+    focus.markAway(state, lastInputTime(Clock::now()));
+    parkIdleCheck();
+}
+
+// 🔓 Unlock / wake: resume once neither lock nor sleep applies
+void resumeObservation(ObserverState& state) {
+    if (state.locked || state.asleep) return;
+    focus.markBack(state, focus.frontmost(), Clock::now());
+    scheduleIdleCheck(static_cast<double>(idleThreshold.count()));
+}
+
+// 🔔 Event-driven observer: NSWorkspace tells us about every activation the moment it happens
+void runEventObserver(ObserverState& state) {
+    ObserverState* observer = &state; // Blocks capture the pointer, not a copy of the state
+    NSNotificationCenter* center = [[NSWorkspace sharedWorkspace] notificationCenter];
+
+    // queue:nil runs the block synchronously on the posting (main) thread, so the timestamp is taken at switch time
+    id token = [center addObserverForName:NSWorkspaceDidActivateApplicationNotification
+                                   object:nil
+                                    queue:nil
+                               usingBlock:^(NSNotification* note) {
+        metrics.count(Counter::ObserverWakeups);
+        NSRunningApplication* app = note.userInfo[NSWorkspaceApplicationKey];
+        Clock::time_point now = Clock::now(); // Stamp before any attribution round-trip
+        tabAttributor.invalidate();           // New activation: the cached tab may be stale
+        focus.recordSwitch(*observer, appIdOf(app), now);
+
+        if (isAttributedBrowser(app)) {
+            startTitleObserver([app processIdentifier], observer);
+        } else {
+            stopTitleObserver();
+        }
+    }];
+
+    // 🧹 Forget a pid once its app quits so a recycled pid is never misattributed
+    id terminateToken = [center addObserverForName:NSWorkspaceDidTerminateApplicationNotification
+                                            object:nil
+                                             queue:nil
+                                        usingBlock:^(NSNotification* note) {
+        NSRunningApplication* app = note.userInfo[NSWorkspaceApplicationKey];
+        if ([app processIdentifier] == titleObserverPid) stopTitleObserver();
+        pidCache.erase([app processIdentifier]);
+    }];
+
+    // 💤 Idle / lock / sleep: pause observation entirely and exclude away time
+    idleTimer = CFRunLoopTimerCreateWithHandler(kCFAllocatorDefault, CFAbsoluteTimeGetCurrent() + 1.0e10, 1.0e10, 0, 0,
+                                                ^(CFRunLoopTimerRef) { onIdleCheck(*observer); });
+    CFRunLoopAddTimer(CFRunLoopGetMain(), idleTimer, kCFRunLoopCommonModes);
+    scheduleIdleCheck(static_cast<double>(idleThreshold.count()));
+
+    // 🔒 Enforcement deadline: fires only when the focused app's allowance runs out (budget spent, window opens)
+    enforcementTimer = CFRunLoopTimerCreateWithHandler(kCFAllocatorDefault, CFAbsoluteTimeGetCurrent() + 1.0e10, 1.0e10,
+                                                       0, 0, ^(CFRunLoopTimerRef) {
+        metrics.count(Counter::ObserverWakeups);
+        CFRunLoopTimerSetNextFireDate(enforcementTimer, CFAbsoluteTimeGetCurrent() + 1.0e10); // Re-armed below
+        focus.enforceFocus(*observer, Clock::now());
+    });
+    CFRunLoopAddTimer(CFRunLoopGetMain(), enforcementTimer, kCFRunLoopCommonModes);
+    focus.enforceFocus(state, Clock::now()); // The app focused at launch
+
+    NSDistributedNotificationCenter* distributed = [NSDistributedNotificationCenter defaultCenter];
+    id lockToken = [distributed addObserverForName:@"com.apple.screenIsLocked" object:nil queue:nil
+                                        usingBlock:^(NSNotification*) {
+        observer->locked = true;
+        pauseObservation(*observer);
+    }];
+    id unlockToken = [distributed addObserverForName:@"com.apple.screenIsUnlocked" object:nil queue:nil
+                                          usingBlock:^(NSNotification*) {
+        observer->locked = false;
+        resumeObservation(*observer);
+    }];
+
+    NSMutableArray* sleepTokens = [NSMutableArray array];
+    for (NSString* name in @[NSWorkspaceScreensDidSleepNotification, NSWorkspaceWillSleepNotification]) {
+        [sleepTokens addObject:[center addObserverForName:name object:nil queue:nil usingBlock:^(NSNotification*) {
+            observer->asleep = true;
+            pauseObservation(*observer);
+        }]];
+    }
+    for (NSString* name in @[NSWorkspaceScreensDidWakeNotification, NSWorkspaceDidWakeNotification]) {
+        [sleepTokens addObject:[center addObserverForName:name object:nil queue:nil usingBlock:^(NSNotification*) {
+            observer->asleep = false;
+            resumeObservation(*observer);
+        }]];
     }
+
+    // 🛑 Shutdown stops the main run loop; the stop is queued as a block so it is not lost if it fires
+    //    before CFRunLoopRun() has been entered
+    CFRunLoopRef mainLoop = CFRunLoopGetMain();
+    std::stop_callback stopLoop(shutdownSource.get_token(), [mainLoop] {
+        CFRunLoopPerformBlock(mainLoop, kCFRunLoopCommonModes, ^{ CFRunLoopStop(mainLoop); });
+        CFRunLoopWakeUp(mainLoop);
+    });
+
+    CFRunLoopRun(); // Sleeps until a notification arrives; no periodic wakeups
+
+    [center removeObserver:token];
+    [center removeObserver:terminateToken];
+    for (id sleepToken in sleepTokens) [center removeObserver:sleepToken];
+    [distributed removeObserver:lockToken];
+    [distributed removeObserver:unlockToken];
+    CFRunLoopTimerInvalidate(idleTimer);
+    CFRelease(idleTimer);
+    idleTimer = nullptr;
+    CFRunLoopTimerInvalidate(enforcementTimer);
+    CFRelease(enforcementTimer);
+    enforcementTimer = nullptr;
+    stopTitleObserver();
 }
 
-int main() {
-    std::unordered_map<std::string, AppSession> sessions; // Track app sessions
+// 🎚️ Polling bounds (--poll-min / --poll-max, seconds)
+std::chrono::milliseconds pollMin(1000);
+std::chrono::milliseconds pollMax(30000);
+
+// 🔁 Polling fallback: samples on an adaptive schedule that backs off while focus is stable and tightens when
+//    switches are frequent (the wait ends early on shutdown)
+void runPollingObserver(ObserverState& state) {
+    AdaptiveInterval schedule(pollMin, pollMax);
+    std::chrono::milliseconds wait = schedule.current();
+    std::stop_token stop = shutdownSource.get_token();
+    std::mutex pollMutex;
+    std::condition_variable_any pollWakeup;
+    std::unique_lock<std::mutex> lock(pollMutex);
+    focus.enforceFocus(state, Clock::now()); // The app focused at launch
+
+    while (!stop.stop_requested()) {
+        pollWakeup.wait_for(lock, stop, wait, [] { return false; });
+        if (stop.stop_requested()) break;
+
+        metrics.count(Counter::ObserverWakeups);
+        Clock::time_point now = Clock::now();
+
+        // 💤 Idle: close the session at the last input and skip app sampling until input resumes
+        if (secondsSinceLastInput() >= static_cast<double>(idleThreshold.count())) {
+            focus.markAway(state, lastInputTime(now));
+            wait = pollMax; // Nothing to attribute until input resumes
+            continue;
+        }
 
-    // Start tracking the current frontmost app
-    std::string currentApp = getFrontmostApp();
-    AppSession currentSession{currentApp, Clock::now()};
+        const AppId before = state.currentApp;
+        const Clock::time_point sessionStart = state.currentStart;
+        if (state.away) {
+            focus.markBack(state, focus.frontmost(), lastInputTime(now));
+        } else {
+            focus.recordSwitch(state, focus.frontmost(), now); // Detect app switch
+        }
 
-    std::cout << "[Lunr] App Usage Logging Started...\n";
+        const bool switched = state.currentApp != before;
+        if (!switched && now >= state.enforceAt) focus.enforceFocus(state, now); // Allowance ran out mid-session
+        wait = schedule.next(switched, std::chrono::duration_cast<std::chrono::milliseconds>(now - sessionStart));
+        metrics.set(Gauge::PollIntervalMs, static_cast<std::uint64_t>(wait.count()));
+        metrics.set(Gauge::PollsPerHour, static_cast<std::uint64_t>(schedule.samplesPerHour()));
+        if (state.enforceAt != Clock::time_point::max()) { // Wake for the deadline instead of sampling faster
+            const auto untilDeadline = std::chrono::duration_cast<std::chrono::milliseconds>(state.enforceAt - now);
+            wait = std::clamp(untilDeadline, std::chrono::milliseconds(1000), wait);
+        }
 
-    // 🚀 Launch the background analyzer thread
-    std::thread analyzerThread(startBehaviorAnalyzer, &sessions);
-    analyzerThread.detach(); // Run independently
+        if (!quietMode) ::write(STDOUT_FILENO, ".", 1); // Visual heartbeat (one unbuffered byte)
+    }
+}
 
-    // 🔁 Main loop: check every 5 seconds for app changes
-    while (true) {
-        std::this_thread::sleep_for(std::chrono::seconds(5)); // Sample every 5 seconds
-        std::string frontApp = getFrontmostApp();
+int main(int argc, char* argv[]) {
+    BehaviorAnalyzer analyzer; // Track app sessions (owned by the analyzer thread while it runs)
+
+    // --poll forces the adaptive sampling loop instead of workspace notifications
+    // --metrics turns on hot-path instrumentation (dumped with every analyzer snapshot)
+    // --quiet runs as a silent daemon (checkpoints, exports and enforcement continue)
+    // --github <login> polls that user's activity hourly (token from $LUNR_GITHUB_TOKEN raises the rate limit)
+    // --fleet <host[:port]> ships journals to a LunrFleet service as --fleet-user (default $USER) / --fleet-team
+    bool usePolling = false;
+    std::string githubUser;
+    std::string fleetService;
+    fleet::Identity fleetIdentity;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--poll") usePolling = true;
+        if (arg == "--metrics") metrics.enable();
+        if (arg == "--no-tabs") tabAttributionEnabled = false; // Skip browser tab attribution (no AppleScript)
+        if (arg == "--poll-min" && i + 1 < argc) pollMin = std::chrono::seconds(std::max(1, std::atoi(argv[++i])));
+        if (arg == "--poll-max" && i + 1 < argc) pollMax = std::chrono::seconds(std::max(1, std::atoi(argv[++i])));
+        if (arg == "--github" && i + 1 < argc) githubUser = argv[++i];
+        if (arg == "--quiet") quietMode = true; // Daemon: no heartbeat dots or periodic snapshots
+        if (arg == "--idle" && i + 1 < argc) idleThreshold = Seconds(std::max(30, std::atoi(argv[++i])));
+        if (arg == "--fleet" && i + 1 < argc) fleetService = argv[++i];
+        if (arg == "--fleet-user" && i + 1 < argc) fleetIdentity.user = argv[++i];
+        if (arg == "--fleet-team" && i + 1 < argc) fleetIdentity.team = argv[++i];
+    }
 
-        // Detect app switch
-        if (frontApp != currentApp) {
-            auto now = Clock::now();
-            Seconds duration = std::chrono::duration_cast<Seconds>(now - currentSession.startTime);
+    // 🌐 Browser backends for per-site attribution (Safari and the Chromium family share their dictionaries)
+    tabAttributor.addBackend(std::make_unique<AppleScriptTabBackend>(
+        std::vector<std::string>{"com.apple.Safari", "com.apple.SafariTechnologyPreview"},
+        "URL of current tab of front window"));
+    tabAttributor.addBackend(std::make_unique<AppleScriptTabBackend>(
+        std::vector<std::string>{"com.google.Chrome", "com.brave.Browser", "com.microsoft.edgemac",
+                                 "company.thebrowser.Browser"},
+        "URL of active tab of front window"));
+
+    // 📡 SIGUSR1 dumps metrics at any time (handled on a libdispatch queue, not in signal context)
+    signal(SIGUSR1, SIG_IGN);
+    dispatch_source_t metricsSignal =
+        dispatch_source_create(DISPATCH_SOURCE_TYPE_SIGNAL, SIGUSR1, 0, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+    dispatch_source_set_event_handler(metricsSignal, ^{ metrics.dump(std::cout); });
+    dispatch_resume(metricsSignal);
+
+    // 🗂️ Optional user category rules ("bundle.id=Category" or "App Name=Category" per line)
+    classifier.loadRules("lunr_categories.txt");
+
+    // 🔒 Optional enforcement rules ("target = block after 2h" etc., see EnforcementEngine.hpp)
+    if (enforcement.loadRules("lunr_rules.txt") > 0) {
+        std::cout << "🔒 " << enforcement.size() << " enforcement rules loaded\n";
+    }
 
-            {
-                std::lock_guard<std::mutex> lock(sessionMutex);
-                sessions[currentApp].appName = currentApp;
-                sessions[currentApp].totalDuration += duration;
-                sessions[currentApp].focusDurations.push_back(duration); // Save current session duration
+    // ♻️ Warm restart: resume today's totals from the last checkpoint (mmapped, no journal replay)
+    checkpoint::Restored restored;
+    if (checkpoint::load(kCheckpointPath, getCurrentDateString(), restored,
+                         [](std::string_view key, std::string_view name) { return appRegistry.intern(key, name); })) {
+        if (restored.sameDay) {
+            const int today = focus.enforcementContext(Clock::now()).dayKey;
+            for (const auto& [app, category] : restored.appCategories) {
+                classifier.restore(app, category);
+                enforcement.bindApp(app, appRegistry.keyOf(app), appRegistry.nameOf(app));
+                const auto seconds = static_cast<std::uint32_t>(restored.sessions[app].totalDuration.count());
+                enforcement.credit(app, category, seconds, today); // Budgets resume where the day left off
             }
-
-            // Start new session
-            currentApp = frontApp;
-            currentSession = AppSession{currentApp, now};
+            for (std::size_t c = 0; c < kCategoryCount; ++c) {
+                categoryUsage.add(static_cast<UsageCategory>(c), restored.categories[c]); // Observer not started yet
+            }
+            std::cout << "♻️ Resumed " << restored.appCategories.size() << " apps from " << kCheckpointPath << "\n";
         }
+        analyzer.restore(restored);
+    }
 
-        std::cout << "." << std::flush; // Visual heartbeat
+    // Start tracking the current frontmost app
+    ObserverState observer{focus.frontmost(), Clock::now()};
 
-        // Exit condition: if user presses Enter
-        if (std::cin.peek() == '\n') break;
+    // 📒 Start the journal writer on today's file (appends if the agent already ran today)
+    if (!flushThread.start()) {
+        std::cout << "⚠️ Could not open today's journal; journaling resumes at the next day.\n";
     }
 
-    // 🔚 Final session tracking before exit
-    auto now = Clock::now();
-    Seconds duration = std::chrono::duration_cast<Seconds>(now - currentSession.startTime);
-    {
-        std::lock_guard<std::mutex> lock(sessionMutex);
-        sessions[currentApp].appName = currentApp;
-        sessions[currentApp].totalDuration += duration;
-        sessions[currentApp].focusDurations.push_back(duration);
+    std::cout << "[Lunr] App Usage Logging Started ("
+              << (usePolling ? "polling" : "event-driven") << " mode)...\n";
+
+    // 🚀 Launch the background analyzer thread
+    analyzer.start();
+    std::jthread exitWatcher = startExitWatcher();
+
+    // 🐙 Optional GitHubThread (never touches the observer's threads; deltas reach the analyzer via its ring)
+    std::unique_ptr<GitHubPoller> githubPoller;
+    if (!githubUser.empty()) {
+        const char* token = std::getenv("LUNR_GITHUB_TOKEN");
+        githubPoller = std::make_unique<GitHubPoller>(
+            std::make_unique<URLSessionGitHubTransport>(token ? token : ""), githubUser, "lunr_github_cursor.txt",
+            contributionEvents, metrics);
+        githubPoller->start();
     }
 
+    // 🛰️ Optional FleetThread (reads the journals the flush thread writes; never touches the observer)
+    std::unique_ptr<FleetUploader> fleetUploader;
+    if (!fleetService.empty()) {
+        char host[256] = {};
+        gethostname(host, sizeof(host) - 1);
+        fleetIdentity.agent = host;
+        if (fleetIdentity.user.empty()) {
+            const char* login = std::getenv("USER");
+            fleetIdentity.user = login ? login : host;
+        }
+        std::uint16_t port = fleet::kDefaultPort;
+        if (const auto colon = fleetService.rfind(':'); colon != std::string::npos) {
+            port = static_cast<std::uint16_t>(std::atoi(fleetService.c_str() + colon + 1));
+            fleetService.resize(colon);
+        }
+        fleetUploader = std::make_unique<FleetUploader>(fleetService, port, fleetIdentity, "lunr_journal_",
+                                                        "lunr_fleet_cursor.txt", metrics);
+        fleetUploader->start();
+        std::cout << "🛰️ Shipping journals to " << fleetService << ":" << port << " as " << fleetIdentity.user
+                  << "\n";
+    }
+
+    if (usePolling) {
+        runPollingObserver(observer);
+    } else {
+        runEventObserver(observer);
+    }
+
+    // 🔚 Final session tracking before exit (nothing is open while away)
+    if (!observer.away) focus.closeCurrentSession(observer, Clock::now());
+
+    // 🛑 Stop the producers, then the analyzer; it wakes at once and drains the rings one last time
+    if (githubPoller) githubPoller->stop();
+    analyzer.stop();
+    flushThread.stop(); // Writes and fsyncs the last batch
+    if (fleetUploader) fleetUploader->stop(); // Ships that batch too
+
     // 📊 Final summary and log file creation
-    printSummary(sessions);
-    writeDailyLog(sessions);
+    ReportWriter summary;
+    printSummary(analyzer.state().sessions, summary);
+    writeDailyLog(analyzer.state().sessions, analyzer.date());
+    exportDailyJson(analyzer.state(), analyzer.date(), analyzer.state().today(categoryUsage.snapshot()));
+    dispatch_source_cancel(metricsSignal);
 
     return 0;
 }
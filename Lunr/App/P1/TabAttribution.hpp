@@ -0,0 +1,87 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <cctype>      // For std::tolower
+#include <cstdint>     // For counters
+#include <memory>      // Owned backends
+#include <string>      // Cached URL / title
+#include <string_view> // Zero-copy comparisons
+#include <vector>      // Backend list
+
+#include <sys/types.h> // For pid_t
+
+#include "AppRegistry.hpp" // AppId
+
+// 🌐 Pluggable source of the active tab URL for one browser family (AppleScript, extension bridge, ...)
+class TabAttributionBackend {
+public:
+    virtual ~TabAttributionBackend() = default;
+
+    // Whether this backend knows how to query the app with `bundleId`
+    virtual bool handles(std::string_view bundleId) const = 0;
+
+    // Active tab URL of the frontmost window, or "" if unavailable (expensive: may be an IPC round-trip)
+    virtual std::string activeTabURL(std::string_view bundleId) = 0;
+};
+
+// 🔎 "https://www.YouTube.com/watch?v=..." → "youtube.com" (host, lowercased, leading "www." dropped)
+inline std::string siteOf(std::string_view url) {
+    const auto scheme = url.find("://");
+    if (scheme != std::string_view::npos) url.remove_prefix(scheme + 3);
+    const auto end = url.find_first_of("/?#:");
+    if (end != std::string_view::npos) url = url.substr(0, end);
+    if (url.size() > 4 && url.substr(0, 4) == "www.") url.remove_prefix(4);
+
+    std::string host(url);
+    for (char& c : host) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return host;
+}
+
+// 🧭 Sub-app attribution for browsers: maps (browser, active tab) to an interned per-site AppId
+//    The backend is only asked when the frontmost pid or its window title changed since the last answer,
+//    so a stable tab costs a string compare per sample instead of an AppleScript round-trip (observer thread only)
+class TabAttributor {
+public:
+    static constexpr int kNoBackend = -1;
+
+    void addBackend(std::unique_ptr<TabAttributionBackend> backend) { backends.push_back(std::move(backend)); }
+
+    // 🔌 Backend index for `bundleId`, or kNoBackend (call once per pid and cache the answer)
+    int backendFor(std::string_view bundleId) const {
+        for (std::size_t i = 0; i < backends.size(); ++i) {
+            if (backends[i]->handles(bundleId)) return static_cast<int>(i);
+        }
+        return kNoBackend;
+    }
+
+    // 🎯 Per-site id for the browser's active tab; falls back to `baseId` when no URL is available.
+    //    intern(std::string_view site) is only called on a cache miss and returns the site's AppId
+    template <typename Intern>
+    AppId resolve(int backend, std::string_view bundleId, pid_t pid, std::string_view windowTitle, AppId baseId,
+                  Intern&& intern) {
+        if (backend == kNoBackend) return baseId;
+        if (cacheValid && pid == cachedPid && windowTitle == cachedTitle) return cachedId;
+
+        ++backendQueries;
+        const std::string site = siteOf(backends[backend]->activeTabURL(bundleId));
+        cachedId = site.empty() ? baseId : intern(std::string_view(site));
+        cachedPid = pid;
+        cachedTitle.assign(windowTitle.data(), windowTitle.size());
+        cacheValid = true;
+        return cachedId;
+    }
+
+    // ♻️ Forget the cached tab (focus moved to another app, or the window's title changed)
+    void invalidate() { cacheValid = false; }
+
+    // 📈 Backend round-trips so far (for instrumentation)
+    std::uint64_t queries() const { return backendQueries; }
+
+private:
+    std::vector<std::unique_ptr<TabAttributionBackend>> backends;
+    bool cacheValid = false;
+    pid_t cachedPid = 0;
+    std::string cachedTitle; // Capacity is reused between queries
+    AppId cachedId = AppRegistry::kUnknown;
+    std::uint64_t backendQueries = 0;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+// 🧱 Standard C++ libraries
+#include <cstddef>     // For std::size_t
+#include <cstdint>     // For std::uint8_t
+#include <string_view> // For parsing category names
+
+// 🗂️ Usage categories from the Phase 1 spec (dense, so totals live in a plain array)
+enum class UsageCategory : std::uint8_t { Other, Productivity, Entertainment, Social, Games, Count };
+
+constexpr std::size_t kCategoryCount = static_cast<std::size_t>(UsageCategory::Count);
+
+inline const char* categoryName(UsageCategory category) {
+    static constexpr const char* names[] = {"Other", "Productivity", "Entertainment", "Social", "Games"};
+    return names[static_cast<std::size_t>(category)];
+}
+
+// 🔎 Parses a category name as written in a rules file ("Productivity", "Games", ...)
+inline bool parseCategory(std::string_view text, UsageCategory& out) {
+    for (std::size_t i = 0; i < kCategoryCount; ++i) {
+        if (text == categoryName(static_cast<UsageCategory>(i))) {
+            out = static_cast<UsageCategory>(i);
+            return true;
+        }
+    }
+    return false;
+}